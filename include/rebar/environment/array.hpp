@@ -0,0 +1,95 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef ARRAY_HPP
+#define ARRAY_HPP
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include <rebar/environment/object.hpp>
+#include <rebar/memory/pool_allocator.hpp>
+
+namespace rebar {
+
+    /**
+     * Storage kinds of array payloads.
+     */
+    enum class array_storage : std::uint8_t {
+        objects,  ///< Elements are stored as objects.
+        integers, ///< Elements are a view of raw integers in external memory.
+        numbers,  ///< Elements are a view of raw numbers in external memory.
+    };
+
+    /**
+     * Access to the external memory viewed by a typed array.
+     */
+    enum class array_access : std::uint8_t {
+        read_only,  ///< Mutating the array first converts it to object storage.
+        read_write, ///< Assigning an element writes through to the external memory.
+    };
+
+    /**
+     * The payload of an array object. Array payloads are allocated from the
+     * pool allocator of the environment that created them, or from the arena
+     * of a frozen graph.
+     *
+     * Typed arrays view raw integers or numbers in memory that is not owned
+     * by the payload (such as a mapped file, or a container of the host).
+     * Mutating a read-only typed array first converts it to object storage;
+     * read-write typed arrays write elements through to the viewed memory.
+     */
+    struct internal_array {
+        std::size_t              reference_count;
+        pool_allocator *         allocator; ///< Allocator of the payload (null if frozen).
+        std::pmr::vector<object> elements = {};
+
+        std::size_t   hash        = 0;                      ///< Memoized structural hash.
+        bool          hash_cached = false;                  ///< Whether the memoized hash is valid.
+        array_storage storage     = array_storage::objects; ///< Storage kind of the elements.
+
+        void const *  view        = nullptr; ///< Typed elements (unless storing objects).
+        std::size_t   view_length = 0;       ///< Amount of typed elements.
+
+        array_access                access = array_access::read_only; ///< Access to the typed elements.
+        std::shared_ptr<void const> view_owner = {}; ///< Keeps the typed elements alive (may be null).
+
+        /**
+         * Retrieve the amount of elements in the array.
+         * @return The element count.
+         */
+        [[nodiscard]]
+        inline std::size_t length() const noexcept;
+
+        /**
+         * Retrieve an element of the array, without bounds checking.
+         * @param a_index The index of the element.
+         * @return A copy of the element.
+         */
+        [[nodiscard]]
+        inline object at(std::size_t a_index) const noexcept;
+    };
+
+    // ###################################### INLINE DEFINITIONS ######################################
+
+    std::size_t internal_array::length() const noexcept {
+        return storage == array_storage::objects ? elements.size() : view_length;
+    }
+
+    object internal_array::at(std::size_t const a_index) const noexcept {
+        switch (storage) {
+            case array_storage::integers:
+                return object(static_cast<integer const *>(view)[a_index]);
+            case array_storage::numbers:
+                return object(static_cast<number const *>(view)[a_index]);
+            default:
+                return elements[a_index];
+        }
+    }
+
+}
+
+#endif //ARRAY_HPP
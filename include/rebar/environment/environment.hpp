@@ -5,22 +5,38 @@
 #ifndef ENVIRONMENT_HPP
 #define ENVIRONMENT_HPP
 
+#include <memory>
+#include <span>
+#include <unordered_map>
+
+#include <rebar/environment/array.hpp>
+#include <rebar/environment/native.hpp>
 #include <rebar/environment/object.hpp>
+#include <rebar/environment/table.hpp>
 #include <rebar/lexical_analysis/lexical_analyzer.hpp>
+#include <rebar/memory/pool_allocator.hpp>
 #include <rebar/semantic_analysis/semantic_analyzer.hpp>
 #include <rebar/string/string_engine.hpp>
 
 namespace rebar {
 
     class environment : string_engine, lexical_analyzer, semantic_analyzer {
+        /// Allocator for fixed-size complex object payloads.
+        std::unique_ptr<pool_allocator> m_pool_allocator;
+
+        /// Global variables, keyed by a view of their interned names.
+        std::unordered_map<std::string_view, std::pair<string, object>> m_globals;
+
     public:
-        inline environment() noexcept;
+        inline environment();
 
-        environment(environment const &)     = delete;
-        environment(environment &&) noexcept = default;
+        // Environments cannot move, as their payloads (such as bound
+        // functions) and analyzers refer back to them.
+        environment(environment const &) = delete;
+        environment(environment &&)      = delete;
 
-        environment & operator = (environment const &)     = delete;
-        environment & operator = (environment &&) noexcept = default;
+        environment & operator = (environment const &) = delete;
+        environment & operator = (environment &&)      = delete;
 
         using string_engine::str;
 
@@ -29,17 +45,232 @@ namespace rebar {
 
         using semantic_analyzer::perform_analysis;
 
+        /**
+         * Create an empty array object.
+         * @param a_reserve The amount of elements for which to reserve space.
+         * @return The created array object.
+         */
+        [[nodiscard]]
+        object array(std::size_t a_reserve = 0);
+
+        /**
+         * Create a read-only array object viewing integers of the host in
+         * place, without copying them.
+         * @param a_elements The elements to view.
+         * @param a_owner A handle keeping the elements alive for as long as
+         *                the array views them, or null if the host otherwise
+         *                guarantees so.
+         * @return The created array object.
+         * @note Changes made by the host are visible through the array.
+         *       Mutating the array copies the elements into object storage.
+         */
+        [[nodiscard]]
+        object array_view(std::span<integer const> a_elements, std::shared_ptr<void const> a_owner = nullptr);
+
+        /**
+         * Create a read-only array object viewing numbers of the host in
+         * place, without copying them.
+         * @param a_elements The elements to view.
+         * @param a_owner A handle keeping the elements alive for as long as
+         *                the array views them, or null if the host otherwise
+         *                guarantees so.
+         * @return The created array object.
+         * @note Changes made by the host are visible through the array.
+         *       Mutating the array copies the elements into object storage.
+         */
+        [[nodiscard]]
+        object array_view(std::span<number const> a_elements, std::shared_ptr<void const> a_owner = nullptr);
+
+        /**
+         * Create an array object viewing integers of the host in place,
+         * without copying them.
+         * @param a_elements The elements to view.
+         * @param a_access The access to the elements granted to the array.
+         * @param a_owner A handle keeping the elements alive for as long as
+         *                the array views them, or null if the host otherwise
+         *                guarantees so.
+         * @return The created array object.
+         * @note With read-write access, assigning elements writes through to
+         *       the host memory, and the length of the array is fixed.
+         */
+        [[nodiscard]]
+        object array_view(std::span<integer> a_elements, array_access a_access, std::shared_ptr<void const> a_owner = nullptr);
+
+        /**
+         * Create an array object viewing numbers of the host in place,
+         * without copying them.
+         * @param a_elements The elements to view.
+         * @param a_access The access to the elements granted to the array.
+         * @param a_owner A handle keeping the elements alive for as long as
+         *                the array views them, or null if the host otherwise
+         *                guarantees so.
+         * @return The created array object.
+         * @note With read-write access, assigning elements writes through to
+         *       the host memory, and the length of the array is fixed.
+         */
+        [[nodiscard]]
+        object array_view(std::span<number> a_elements, array_access a_access, std::shared_ptr<void const> a_owner = nullptr);
+
+        /**
+         * Create an empty table object.
+         * @param a_mode How the table holds its entries.
+         * @return The created table object.
+         */
+        [[nodiscard]]
+        object table(table_mode a_mode = table_mode::strong);
+
+        /**
+         * Create a function object calling a native function. Argument
+         * unpacking and result boxing are generated from the signature of
+         * the native function at compile time.
+         * @param a_function The native function or member function pointer
+         *                   to call. Member functions take the native object
+         *                   on which to call them as their first argument.
+         * @return The created function object.
+         */
+        template <native_function t_function>
+        [[nodiscard]]
+        object function(t_function a_function);
+
+        /**
+         * Create a function object calling a native function known at
+         * compile time. The target is called directly by the generated
+         * thunk instead of through a stored pointer.
+         * @tparam v_function The native function or member function pointer
+         *                    to call.
+         * @return The created function object.
+         */
+        template <auto v_function>
+        [[nodiscard]]
+        object function() requires(native_function<decltype(v_function)>);
+
+        /**
+         * Bind a native function to a global name.
+         * @param a_name The global name under which to bind the function.
+         * @param a_function The native function or member function pointer
+         *                   to bind.
+         */
+        template <native_function t_function>
+        void bind(std::string_view a_name, t_function a_function);
+
+        /**
+         * Bind a native function known at compile time to a global name.
+         * @tparam v_function The native function or member function pointer
+         *                    to bind.
+         * @param a_name The global name under which to bind the function.
+         */
+        template <auto v_function>
+        void bind(std::string_view a_name) requires(native_function<decltype(v_function)>);
+
+        /**
+         * Box a C++ value into a native object.
+         * @param a_value The value to store in the object.
+         * @return The created native object.
+         */
+        template <typename t_type>
+        [[nodiscard]]
+        object native(t_type a_value);
+
+        /**
+         * Retrieve the value of a global variable.
+         * @param a_name The name of the global variable.
+         * @return The value of the global, or null if it does not exist.
+         */
+        [[nodiscard]]
+        object global(std::string_view a_name) const;
+
+        /**
+         * Set the value of a global variable.
+         * @param a_name The name of the global variable.
+         * @param a_value The value to assign.
+         */
+        void set_global(std::string_view a_name, object a_value);
+
+        /**
+         * Retrieve the allocator used for complex object payloads.
+         * @return The payload allocator of the environment.
+         */
+        [[nodiscard]]
+        inline pool_allocator & allocator() noexcept;
+
+        /**
+         * Collect the occupancy statistics of the payload allocator, for use
+         * in tuning the allocator size classes.
+         * @return The current allocator statistics.
+         */
+        [[nodiscard]]
+        inline pool_statistics allocator_statistics() const noexcept;
+
     private:
+        /**
+         * Create a typed array object viewing elements in external memory.
+         */
+        [[nodiscard]]
+        object typed_array(array_storage a_storage, void const * a_view, std::size_t a_length, array_access a_access, std::shared_ptr<void const> a_owner);
+
         friend void rebar::reference_object(object const * a_object) noexcept;
         friend void rebar::dereference_object(object const * a_object) noexcept;
     };
 
     // ###################################### INLINE DEFINITIONS ######################################
 
-    environment::environment() noexcept :
-        lexical_analyzer(dynamic_cast<string_engine &>(*this))
+    environment::environment() :
+        lexical_analyzer(dynamic_cast<string_engine &>(*this)),
+        m_pool_allocator(std::make_unique<pool_allocator>())
     {}
 
+    pool_allocator & environment::allocator() noexcept {
+        return *m_pool_allocator;
+    }
+
+    pool_statistics environment::allocator_statistics() const noexcept {
+        return m_pool_allocator->statistics();
+    }
+
+    template <native_function t_function>
+    object environment::function(t_function const a_function) {
+        auto * const function = m_pool_allocator->construct<internal_function>(
+            1ull,
+            this,
+            &native_binding<t_function>::thunk
+        );
+
+        std::memcpy(function->target.data(), &a_function, sizeof(t_function));
+
+        return { type::function, std::bit_cast<object_data>(function) };
+    }
+
+    template <auto v_function>
+    object environment::function() requires(native_function<decltype(v_function)>) {
+        auto * const function = m_pool_allocator->construct<internal_function>(
+            1ull,
+            this,
+            &native_binding<decltype(v_function), v_function>::thunk
+        );
+
+        return { type::function, std::bit_cast<object_data>(function) };
+    }
+
+    template <native_function t_function>
+    void environment::bind(std::string_view const a_name, t_function const a_function) {
+        set_global(a_name, function(a_function));
+    }
+
+    template <auto v_function>
+    void environment::bind(std::string_view const a_name) requires(native_function<decltype(v_function)>) {
+        set_global(a_name, function<v_function>());
+    }
+
+    template <typename t_type>
+    object environment::native(t_type a_value) {
+        auto * const native = m_pool_allocator->construct<internal_native_value<t_type>>(
+            internal_native{ 1ull, m_pool_allocator.get(), &native_type_info_v<t_type> },
+            std::move(a_value)
+        );
+
+        return { type::native, std::bit_cast<object_data>(static_cast<internal_native *>(native)) };
+    }
+
 
 }
 
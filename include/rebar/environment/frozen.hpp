@@ -0,0 +1,138 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef FROZEN_HPP
+#define FROZEN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+
+#include <rebar/environment/object.hpp>
+#include <rebar/memory/arena.hpp>
+
+namespace rebar {
+
+    /**
+     * An immutable, immortal copy of a graph of tables, arrays and strings,
+     * laid out in a single arena.
+     *
+     * Frozen payloads have an immortal reference count, so copying and
+     * releasing frozen objects never writes to them, and their hashes are
+     * computed ahead of time. A frozen graph can therefore be read from any
+     * number of threads and environments at once without atomic operations
+     * or locks. Frozen objects must not outlive the graph that owns them.
+     *
+     * Graphs loaded from the binary graph format (see serialize_graph())
+     * view the strings and typed arrays of the serialized data in place.
+     */
+    class frozen_graph {
+        std::shared_ptr<void const> m_storage; ///< Keeps viewed external memory alive.
+        std::unique_ptr<arena>      m_arena;
+        object                      m_root;
+
+    public:
+        frozen_graph(frozen_graph const &)     = delete;
+        frozen_graph(frozen_graph &&) noexcept = default;
+
+        frozen_graph & operator = (frozen_graph const &) = delete;
+        frozen_graph & operator = (frozen_graph &&)      = delete;
+
+        /**
+         * Freeze a graph of objects. Shared payloads are copied once, and
+         * equal strings are stored once.
+         * @param a_object The root of the graph to freeze.
+         * @return The frozen graph.
+         * @note Throws std::invalid_argument if the graph contains functions
+         *       or natives. Cyclic graphs are not supported.
+         */
+        [[nodiscard]]
+        static frozen_graph freeze(object const & a_object);
+
+        /**
+         * Load a graph serialized with serialize_graph(). String characters
+         * and typed arrays are viewed in place rather than copied. Arrays of
+         * objects and tables are rebuilt in the graph's arena element by
+         * element, as objects hold payload pointers rather than offsets, and
+         * table entries are rehashed into a new index.
+         * @param a_data The serialized graph. Must be aligned to 8 bytes.
+         * @param a_storage An optional handle keeping the serialized data
+         *                  alive; otherwise the data must outlive the graph.
+         * @return The loaded graph.
+         * @note Throws std::runtime_error if the data is malformed.
+         */
+        [[nodiscard]]
+        static frozen_graph load(std::span<std::byte const> a_data, std::shared_ptr<void const> a_storage = nullptr);
+
+        /**
+         * Map a file written by write_graph() into memory and load the graph
+         * it contains (see load()). The mapping lives as long as the graph.
+         * @param a_path The path of the file.
+         * @return The loaded graph.
+         * @note Throws std::runtime_error if the file cannot be mapped or is
+         *       malformed.
+         */
+        [[nodiscard]]
+        static frozen_graph load_file(std::filesystem::path const & a_path);
+
+        /**
+         * Retrieve the frozen copy of the root of the graph.
+         * @return The frozen root object.
+         */
+        [[nodiscard]]
+        inline object const & root() const noexcept;
+
+        /**
+         * Retrieve the amount of bytes occupied by the frozen graph.
+         * @return The used byte count of the arena.
+         */
+        [[nodiscard]]
+        inline std::size_t size() const noexcept;
+
+    private:
+        struct freeze_state;
+        struct load_state;
+
+        inline frozen_graph(std::shared_ptr<void const> a_storage, std::unique_ptr<arena> a_arena, object a_root) noexcept;
+
+        [[nodiscard]]
+        static object freeze_object(freeze_state & a_state, object const & a_object);
+
+        [[nodiscard]]
+        static object load_object(load_state & a_state, std::uint64_t a_type, std::uint64_t a_data);
+
+        /**
+         * Load a value whose node, if it has one, has already been loaded.
+         * @return The value, or nullopt if its node is yet to be loaded.
+         */
+        [[nodiscard]]
+        static std::optional<object> loaded_value(load_state & a_state, std::uint64_t a_type, std::uint64_t a_data);
+
+        /// Construct an array or table node once all of its children have been loaded.
+        [[nodiscard]]
+        static object load_node(load_state & a_state, std::uint64_t a_offset, type a_type);
+    };
+
+    // ###################################### INLINE DEFINITIONS ######################################
+
+    frozen_graph::frozen_graph(std::shared_ptr<void const> a_storage, std::unique_ptr<arena> a_arena, object a_root) noexcept :
+        m_storage(std::move(a_storage)),
+        m_arena(std::move(a_arena)),
+        m_root(std::move(a_root))
+    {}
+
+    object const & frozen_graph::root() const noexcept {
+        return m_root;
+    }
+
+    std::size_t frozen_graph::size() const noexcept {
+        return m_arena->used_bytes();
+    }
+
+}
+
+#endif //FROZEN_HPP
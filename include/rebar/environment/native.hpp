@@ -0,0 +1,383 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef NATIVE_HPP
+#define NATIVE_HPP
+
+#include <array>
+#include <concepts>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <rebar/environment/object.hpp>
+#include <rebar/memory/pool_allocator.hpp>
+
+namespace rebar {
+
+    class environment;
+    struct internal_function;
+    struct internal_native;
+
+    /**
+     * A generated function that unpacks the arguments of a call, invokes a
+     * bound native function, and boxes its result.
+     * @param a_env The environment in which the call takes place.
+     * @param a_function The payload of the called function object.
+     * @param a_arguments The arguments of the call.
+     * @return The boxed result of the call.
+     */
+    using native_thunk = object (*)(environment & a_env, internal_function const & a_function, std::span<object const> a_arguments);
+
+    /// Maximum size of a native function target stored in a function object.
+    constexpr std::size_t native_target_size = 16;
+
+    /**
+     * The payload of a function object. Function payloads are allocated
+     * from the pool allocator of the environment that created them.
+     */
+    struct internal_function {
+        std::size_t                                  reference_count;
+        environment *                                env; ///< Environment in which the function is called.
+        native_thunk                                 thunk;
+        std::array<std::byte, native_target_size>    target = {}; /**< Target function or member
+                                                                   *   function pointer (unused if
+                                                                   *   the target was bound at
+                                                                   *   compile time).
+                                                                   */
+    };
+
+    /**
+     * Type information shared by all native objects of a single C++ type.
+     * Native objects are type-checked by comparing the address of their type
+     * information.
+     */
+    struct native_type_info {
+        std::size_t size;
+
+        /// Destroys a native payload and returns it to the allocator.
+        void (*destroy)(internal_native * a_native, pool_allocator & a_allocator) noexcept;
+
+        /// Hashes the value of a native payload.
+        std::size_t (*hash)(internal_native const * a_native);
+
+        /// Compares the values of two native payloads of this type.
+        bool (*equal)(internal_native const * a_lhs, internal_native const * a_rhs);
+    };
+
+    /**
+     * The common header of a native object payload.
+     */
+    struct internal_native {
+        std::size_t              reference_count;
+        pool_allocator *         allocator; ///< Allocator of the payload.
+        native_type_info const * type_info;
+    };
+
+    /**
+     * The payload of a native object storing a value of a specific C++ type.
+     * @tparam t_type The type of the stored value.
+     */
+    template <typename t_type>
+    struct internal_native_value : internal_native {
+        t_type value;
+    };
+
+    /**
+     * Type information of native objects of a C++ type.
+     *
+     * Values are hashed with std::hash and compared with operator == where
+     * the type supports them; otherwise natives are compared by identity.
+     * @tparam t_type The type of the native value.
+     */
+    template <typename t_type>
+    inline constexpr native_type_info native_type_info_v{
+        .size    = sizeof(t_type),
+        .destroy = [](internal_native * const a_native, pool_allocator & a_allocator) noexcept {
+            a_allocator.destroy(static_cast<internal_native_value<t_type> *>(a_native));
+        },
+        .hash    = [](internal_native const * const a_native) -> std::size_t {
+            auto const & value = static_cast<internal_native_value<t_type> const *>(a_native)->value;
+
+            if constexpr (requires { { std::hash<t_type>{}(value) } -> std::convertible_to<std::size_t>; }) {
+                return std::hash<t_type>{}(value);
+            }
+            else if constexpr (std::equality_comparable<t_type>) {
+                // Equal values must hash alike, but cannot be hashed.
+                return 0;
+            }
+            else {
+                return std::hash<void const *>{}(a_native);
+            }
+        },
+        .equal   = [](internal_native const * const a_lhs, internal_native const * const a_rhs) -> bool {
+            if constexpr (std::equality_comparable<t_type>) {
+                return
+                    static_cast<internal_native_value<t_type> const *>(a_lhs)->value ==
+                    static_cast<internal_native_value<t_type> const *>(a_rhs)->value;
+            } else {
+                return a_lhs == a_rhs;
+            }
+        },
+    };
+
+    /**
+     * Retrieve the value stored in a native object.
+     * @tparam t_type The C++ type of the stored value.
+     * @param a_object The object from which to retrieve the value.
+     * @return A pointer to the stored value, or nullptr if the object is not
+     *         a native object storing a value of the requested type.
+     */
+    template <typename t_type>
+    [[nodiscard]]
+    t_type * native_cast(object const & a_object) noexcept {
+        if (!a_object.is_native()) {
+            return nullptr;
+        }
+
+        auto * const native = a_object.as_internal_native();
+
+        if (native->type_info != &native_type_info_v<std::remove_cv_t<t_type>>) {
+            return nullptr;
+        }
+
+        return &static_cast<internal_native_value<std::remove_cv_t<t_type>> *>(native)->value;
+    }
+
+    /**
+     * Test if a C++ type is passed to and from Rebar as a native object
+     * (rather than converted to a Rebar value type).
+     * @tparam t_type The type to test.
+     */
+    template <typename t_type>
+    constexpr bool is_native_value_type_v =
+        !std::is_arithmetic_v<t_type>                 &&
+        !std::is_pointer_v<t_type>                    &&
+        !std::is_same_v<t_type, object>               &&
+        !std::is_same_v<t_type, string>               &&
+        !std::is_same_v<t_type, std::string>          &&
+        !std::is_same_v<t_type, std::string_view>     &&
+        !std::is_void_v<t_type>;
+
+    /**
+     * Signature information of a bindable native function.
+     *
+     * Member function pointers take the object on which they are called as
+     * their first argument, which must be a native object of the class type.
+     */
+    template <typename t_function>
+    struct native_signature;
+
+    template <typename t_result, typename ...t_parameters>
+    struct native_signature<t_result (*)(t_parameters...)> {
+        using result    = t_result;
+        using arguments = std::tuple<t_parameters...>;
+    };
+
+    template <typename t_result, typename ...t_parameters>
+    struct native_signature<t_result (*)(t_parameters...) noexcept> :
+        native_signature<t_result (*)(t_parameters...)>
+    {};
+
+    template <typename t_result, typename t_class, typename ...t_parameters>
+    struct native_signature<t_result (t_class::*)(t_parameters...)> {
+        using result    = t_result;
+        using arguments = std::tuple<t_class &, t_parameters...>;
+    };
+
+    template <typename t_result, typename t_class, typename ...t_parameters>
+    struct native_signature<t_result (t_class::*)(t_parameters...) const> {
+        using result    = t_result;
+        using arguments = std::tuple<t_class const &, t_parameters...>;
+    };
+
+    template <typename t_result, typename t_class, typename ...t_parameters>
+    struct native_signature<t_result (t_class::*)(t_parameters...) noexcept> :
+        native_signature<t_result (t_class::*)(t_parameters...)>
+    {};
+
+    template <typename t_result, typename t_class, typename ...t_parameters>
+    struct native_signature<t_result (t_class::*)(t_parameters...) const noexcept> :
+        native_signature<t_result (t_class::*)(t_parameters...) const>
+    {};
+
+    /**
+     * A function or member function pointer that can be bound to Rebar.
+     */
+    template <typename t_function>
+    concept native_function = requires {
+        typename native_signature<t_function>::result;
+    };
+
+    /**
+     * Unpack a Rebar call argument into a native parameter. Performs type
+     * checking, throwing std::invalid_argument on mismatches.
+     * @tparam t_parameter The type of the native parameter.
+     * @param a_argument The argument to unpack.
+     * @param a_index The index of the argument (for diagnostics).
+     * @return The unpacked value (or a reference to it).
+     */
+    template <typename t_parameter>
+    decltype(auto) unpack_native_argument(object const & a_argument, std::size_t const a_index) {
+        using value_type = std::remove_cvref_t<t_parameter>;
+
+        auto const expect_type = [&a_argument, a_index](bool const a_matches, std::string_view const a_expected) {
+            if (!a_matches) [[unlikely]] {
+                throw std::invalid_argument(fmt::format(
+                    "Native function argument {} must be of type {}.",
+                    a_index,
+                    a_expected
+                ));
+            }
+        };
+
+        if constexpr (std::is_same_v<value_type, object>) {
+            return (a_argument);
+        }
+        else if constexpr (std::is_same_v<value_type, bool>) {
+            expect_type(a_argument.is_boolean(), "boolean");
+            return a_argument.get_boolean() != _false;
+        }
+        else if constexpr (std::is_integral_v<value_type>) {
+            expect_type(a_argument.is_integer(), "integer");
+            return static_cast<value_type>(a_argument.get_integer());
+        }
+        else if constexpr (std::is_floating_point_v<value_type>) {
+            if (a_argument.is_integer()) {
+                return static_cast<value_type>(a_argument.get_integer());
+            }
+
+            expect_type(a_argument.is_number(), "number");
+            return static_cast<value_type>(a_argument.get_number());
+        }
+        else if constexpr (std::is_same_v<value_type, std::string_view>) {
+            expect_type(a_argument.is_string(), "string");
+            return a_argument.string_view();
+        }
+        else if constexpr (std::is_same_v<value_type, std::string>) {
+            expect_type(a_argument.is_string(), "string");
+            return std::string(a_argument.string_view());
+        }
+        else if constexpr (std::is_same_v<value_type, string>) {
+            expect_type(a_argument.is_string(), "string");
+            return a_argument.get_string();
+        }
+        else if constexpr (std::is_pointer_v<value_type>) {
+            using pointee_type = std::remove_cv_t<std::remove_pointer_t<value_type>>;
+
+            if (a_argument.is_null()) {
+                return static_cast<value_type>(nullptr);
+            }
+
+            auto * const native_value = native_cast<pointee_type>(a_argument);
+            expect_type(native_value != nullptr, "native");
+
+            return static_cast<value_type>(native_value);
+        }
+        else {
+            static_assert(is_native_value_type_v<value_type>, "Unsupported native parameter type.");
+
+            auto * const native_value = native_cast<value_type>(a_argument);
+            expect_type(native_value != nullptr, "native");
+
+            return (*native_value);
+        }
+    }
+
+    /**
+     * Box a native value into a Rebar object.
+     * @tparam t_environment The environment type (deduced).
+     * @param a_env The environment in which to box the value.
+     * @param a_value The value to box.
+     * @return The boxed value.
+     */
+    template <typename t_environment, typename t_value>
+    object box_native_value(t_environment & a_env, t_value && a_value) {
+        using value_type = std::remove_cvref_t<t_value>;
+
+        if constexpr (std::is_same_v<value_type, object>) {
+            return std::forward<t_value>(a_value);
+        }
+        else if constexpr (std::is_same_v<value_type, bool>) {
+            return object(a_value ? _true : _false);
+        }
+        else if constexpr (std::is_integral_v<value_type>) {
+            return object(static_cast<integer>(a_value));
+        }
+        else if constexpr (std::is_floating_point_v<value_type>) {
+            return object(static_cast<number>(a_value));
+        }
+        else if constexpr (std::is_same_v<value_type, string>) {
+            return object(std::forward<t_value>(a_value));
+        }
+        else if constexpr (std::is_convertible_v<value_type, std::string_view>) {
+            return object(a_env.str(std::string_view(a_value)));
+        }
+        else {
+            static_assert(is_native_value_type_v<value_type>, "Unsupported native return type.");
+            return a_env.native(std::forward<t_value>(a_value));
+        }
+    }
+
+    /**
+     * Generates the thunk of a bound native function.
+     * @tparam t_function The type of the native function.
+     * @tparam v_function The native function, if bound at compile time. If
+     *                    null, the target is read from the function object.
+     */
+    template <native_function t_function, t_function v_function = nullptr>
+    struct native_binding {
+        using signature = native_signature<t_function>;
+        using arguments = typename signature::arguments;
+
+        static constexpr std::size_t arity = std::tuple_size_v<arguments>;
+
+        static_assert(sizeof(t_function) <= native_target_size);
+
+        static object thunk(environment & a_env, internal_function const & a_function, std::span<object const> a_arguments) {
+            if (a_arguments.size() != arity) [[unlikely]] {
+                throw std::invalid_argument(fmt::format(
+                    "Native function expects {} arguments, received {}.",
+                    arity,
+                    a_arguments.size()
+                ));
+            }
+
+            t_function target = v_function;
+
+            if constexpr (v_function == nullptr) {
+                std::memcpy(&target, a_function.target.data(), sizeof(t_function));
+            }
+
+            return [&]<std::size_t ...v_indices>(std::index_sequence<v_indices...>) {
+                if constexpr (std::is_void_v<typename signature::result>) {
+                    std::invoke(
+                        target,
+                        unpack_native_argument<std::tuple_element_t<v_indices, arguments>>(a_arguments[v_indices], v_indices)...
+                    );
+
+                    return object();
+                } else {
+                    return box_native_value(
+                        a_env,
+                        std::invoke(
+                            target,
+                            unpack_native_argument<std::tuple_element_t<v_indices, arguments>>(a_arguments[v_indices], v_indices)...
+                        )
+                    );
+                }
+            }(std::make_index_sequence<arity>{});
+        }
+    };
+
+}
+
+#endif //NATIVE_HPP
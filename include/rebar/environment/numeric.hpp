@@ -0,0 +1,87 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef NUMERIC_HPP
+#define NUMERIC_HPP
+
+#include <cmath>
+#include <compare>
+
+#include <rebar/environment/types.hpp>
+
+namespace rebar {
+
+    /**
+     * Test if a number is integral and representable as an integer, in which
+     * case it must equal and hash like that integer.
+     * @param a_number The number to test.
+     * @return Whether the number is an integral value in the integer range.
+     */
+    [[nodiscard]]
+    inline bool integral_number(number a_number) noexcept;
+
+    /**
+     * Compare an integer and a number exactly, rather than after rounding the
+     * integer to a number, so that equality agrees with hashing.
+     * @param a_integer The integer to compare.
+     * @param a_number The number to compare.
+     * @return Whether the two values are equal.
+     */
+    [[nodiscard]]
+    inline bool integer_equals_number(integer a_integer, number a_number) noexcept;
+
+    /**
+     * Order an integer relative to a number exactly.
+     * @param a_integer The integer to compare.
+     * @param a_number The number to compare.
+     * @return The ordering of the integer relative to the number, which is
+     *         unordered if the number is NaN.
+     */
+    [[nodiscard]]
+    inline std::partial_ordering compare_integer_number(integer a_integer, number a_number) noexcept;
+
+    // ###################################### INLINE DEFINITIONS ######################################
+
+    namespace detail {
+
+        /// 2^63, the first number above the integer range.
+        constexpr number integer_limit = 9223372036854775808.0;
+
+    }
+
+    bool integral_number(number const a_number) noexcept {
+        return std::trunc(a_number) == a_number && a_number >= -detail::integer_limit && a_number < detail::integer_limit;
+    }
+
+    bool integer_equals_number(integer const a_integer, number const a_number) noexcept {
+        return integral_number(a_number) && static_cast<integer>(a_number) == a_integer;
+    }
+
+    std::partial_ordering compare_integer_number(integer const a_integer, number const a_number) noexcept {
+        if (std::isnan(a_number)) {
+            return std::partial_ordering::unordered;
+        }
+
+        if (a_number >= detail::integer_limit) {
+            return std::partial_ordering::less;
+        }
+
+        if (a_number < -detail::integer_limit) {
+            return std::partial_ordering::greater;
+        }
+
+        // Within the integer range, the integral part converts exactly; the
+        // fractional part only decides between equal integral parts.
+        auto const integral_part = std::trunc(a_number);
+
+        if (auto const order = a_integer <=> static_cast<integer>(integral_part); order != 0) {
+            return order;
+        }
+
+        return integral_part <=> a_number;
+    }
+
+}
+
+#endif //NUMERIC_HPP
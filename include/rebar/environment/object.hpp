@@ -5,6 +5,9 @@
 #ifndef OBJECT_HPP
 #define OBJECT_HPP
 
+#include <initializer_list>
+#include <span>
+
 #include <rebar/environment/types.hpp>
 #include <rebar/string/string.hpp>
 
@@ -13,16 +16,24 @@ namespace rebar {
     class environment;
     class object;
 
+    struct internal_array;
+    struct internal_function;
+    struct internal_native;
+    struct internal_table;
+    class compact_table;
+
+    template <typename t_type>
+    t_type * native_cast(object const & a_object) noexcept;
+
     using object_data = std::uint64_t;
 
     void reference_object(object const * a_object) noexcept;
     void dereference_object(object const * a_object) noexcept;
 
     class object {
-        /// If object is of type string, this value is of type string_engine*,
-        /// otherwise, it is either nullptr or environment*.
-        void mutable * m_env;
-
+        // Owners of complex payloads (string engine, pool allocator or
+        // environment) are reached through the payload header, so an object
+        // is only a type tag and a payload word.
         type m_type;
         object_data m_data;
 
@@ -70,6 +81,9 @@ namespace rebar {
         [[nodiscard]]
         inline bool is_null() const noexcept;
 
+        [[nodiscard]]
+        inline bool is_boolean() const noexcept;
+
         [[nodiscard]]
         inline bool is_integer() const noexcept;
 
@@ -91,52 +105,280 @@ namespace rebar {
         [[nodiscard]]
         inline bool is_native() const noexcept;
 
+        [[nodiscard]]
+        inline boolean get_boolean() const noexcept;
+
+        [[nodiscard]]
+        inline integer get_integer() const noexcept;
+
+        [[nodiscard]]
+        inline number get_number() const noexcept;
+
+        /**
+         * Retrieve the string of a string object. Creates a new reference.
+         * @return The string of the object.
+         * @note The object must be a string.
+         */
+        [[nodiscard]]
+        inline string get_string() const noexcept;
+
+        /**
+         * View the characters of a string object without creating a new
+         * reference.
+         * @return A view of the string, valid while the object is alive.
+         * @note The object must be a string.
+         */
+        [[nodiscard]]
+        inline std::string_view string_view() const noexcept;
+
+        /**
+         * Test if two objects are identical: of the same type and holding the
+         * same value, or referring to the same payload for complex types.
+         * @param a_object The object with which to compare.
+         * @return Whether the objects are identical.
+         */
+        [[nodiscard]]
+        inline bool identical(object const & a_object) const noexcept;
+
+        /**
+         * Test if the object is frozen (see frozen_graph). Frozen objects are
+         * immutable and immortal, and can be read from any thread.
+         * @return Whether the object is a frozen complex object.
+         */
+        [[nodiscard]]
+        inline bool is_frozen() const noexcept;
+
+        /**
+         * Compute the structural hash of the object. Objects that are equal
+         * (see equals()) have equal hashes.
+         *
+         * The hashes of arrays and tables are memoized in their payloads and
+         * invalidated on mutation. As containers are copied on write, nested
+         * containers can only change through their parents, so memoized hashes
+         * stay valid for whole structures; only containers that (directly or
+         * indirectly) hold natives, which can be mutated in place, recompute
+         * their hashes.
+         * @return The hash of the object.
+         * @note Cyclic structures are not supported.
+         */
+        [[nodiscard]]
+        std::size_t hash() const;
+
+        /**
+         * Test if the hash of an array or table object is memoized, so that
+         * hashing it again takes constant time.
+         * @return Whether the hash is memoized (always false for other types).
+         */
+        [[nodiscard]]
+        bool hash_memoized() const noexcept;
+
+        /**
+         * Test the structural equality of two objects. Integers and numbers
+         * are compared numerically, arrays and tables by their contents,
+         * natives by the equality of their values (or by identity if the
+         * native type has no equality operator), and all other objects by
+         * identity.
+         * @param a_object The object with which to compare.
+         * @return Whether the objects are equal.
+         * @note Cyclic structures are not supported.
+         */
+        [[nodiscard]]
+        bool equals(object const & a_object) const;
+
+        /**
+         * Call a function object.
+         * @param a_arguments The arguments with which to call the function.
+         * @return The result of the call.
+         * @note The object must be a function. Throws std::invalid_argument if
+         *       the arguments do not match the function's parameters.
+         */
+        object call(std::span<object const> a_arguments) const;
+
+        /**
+         * Call a function object.
+         * @param a_arguments The arguments with which to call the function.
+         * @return The result of the call.
+         * @note The object must be a function. Throws std::invalid_argument if
+         *       the arguments do not match the function's parameters.
+         */
+        inline object call(std::initializer_list<object> a_arguments) const;
+
+        /**
+         * Retrieve the length of an array object.
+         * @return The amount of elements in the array.
+         * @note The object must be an array.
+         */
+        [[nodiscard]]
+        std::size_t array_length() const noexcept;
+
+        /**
+         * Retrieve an element of an array object.
+         * @param a_index The index of the element to retrieve.
+         * @return A copy of the element.
+         * @note The object must be an array. Throws std::out_of_range if the
+         *       index is out of bounds.
+         */
+        [[nodiscard]]
+        object array_at(std::size_t a_index) const;
+
+        /**
+         * Replace an element of an array object.
+         * @param a_index The index of the element to replace.
+         * @param a_value The new value of the element.
+         * @note The object must be an array. Throws std::out_of_range if the
+         *       index is out of bounds, or std::logic_error if the array is
+         *       frozen.
+         * @note Copies the array first if it is shared with other objects
+         *       (copy-on-write).
+         */
+        void array_set(std::size_t a_index, object a_value);
+
+        /**
+         * Append an element to an array object.
+         * @param a_value The value to append.
+         * @note The object must be an array. Throws std::logic_error if the
+         *       array is frozen.
+         * @note Copies the array first if it is shared with other objects
+         *       (copy-on-write).
+         */
+        void array_push(object a_value);
+
+        /**
+         * Retrieve the amount of entries in a table object.
+         * @return The amount of entries in the table.
+         * @note The object must be a table.
+         */
+        [[nodiscard]]
+        std::size_t table_size() const noexcept;
+
+        /**
+         * Retrieve the entries of a table object, in insertion order.
+         * @return The entries of the table.
+         * @note The object must be a table. The entries are invalidated by
+         *       any mutation of the table.
+         */
+        [[nodiscard]]
+        compact_table const & table_entries() const noexcept;
+
+        /**
+         * Retrieve the value of an entry of a table object.
+         * @param a_key The key of the entry.
+         * @return A copy of the value, or null if the table has no such entry.
+         * @note The object must be a table.
+         */
+        [[nodiscard]]
+        object table_get(object const & a_key) const;
+
+        /**
+         * Set the value of an entry of a table object. Assigning null removes
+         * the entry.
+         * @param a_key The key of the entry. Must not be null or NaN.
+         * @param a_value The value of the entry.
+         * @note The object must be a table. Throws std::invalid_argument if the
+         *       key is null or NaN, or std::logic_error if the table is frozen.
+         * @note Copies the table first if it is shared with other objects
+         *       (copy-on-write).
+         */
+        void table_set(object a_key, object a_value);
+
     private:
+        /**
+         * Construct a complex object from an already-referenced payload.
+         * Takes ownership of the reference; does not create a new one.
+         */
+        inline object(type a_type, object_data a_data) noexcept;
+
+        [[nodiscard]]
+        inline internal_array * as_internal_array() const noexcept;
+
+        [[nodiscard]]
+        inline internal_function * as_internal_function() const noexcept;
+
+        [[nodiscard]]
+        inline internal_native * as_internal_native() const noexcept;
+
+        [[nodiscard]]
+        inline internal_table * as_internal_table() const noexcept;
+
+        /**
+         * Retrieve the payload of an array object for mutation, copying it
+         * first if it is shared with other objects.
+         */
+        [[nodiscard]]
+        internal_array * unique_array();
+
+        /**
+         * Retrieve the payload of a table object for mutation, copying it
+         * first if it is shared with other objects.
+         */
+        [[nodiscard]]
+        internal_table * unique_table();
+
         [[nodiscard]]
         inline std::size_t type_integer() const noexcept;
 
         [[nodiscard]]
         inline internal_string * as_internal_string() const noexcept;
 
+        friend class compact_table;
+        friend class environment;
+        friend class frozen_graph;
+        friend class graph_writer;
+
+        template <typename t_type>
+        friend t_type * rebar::native_cast(object const & a_object) noexcept;
+
         friend void rebar::reference_object(object const * a_object) noexcept;
         friend void rebar::dereference_object(object const * a_object) noexcept;
     };
 
+    static_assert(sizeof(object) == 16, "Objects must remain a type tag and a single payload word.");
+
+    /// Structural hash of objects, for use in unordered containers.
+    struct object_hash {
+        [[nodiscard]]
+        std::size_t operator () (object const & a_object) const {
+            return a_object.hash();
+        }
+    };
+
+    /// Structural equality of objects, for use in unordered containers.
+    struct object_equal {
+        [[nodiscard]]
+        bool operator () (object const & a_lhs, object const & a_rhs) const {
+            return a_lhs.equals(a_rhs);
+        }
+    };
+
     // ###################################### INLINE DEFINITIONS ######################################
 
     object::object() noexcept :
-        m_env(nullptr),
         m_type(type::null),
         m_data(0)
     {}
 
     object::object(boolean const a_boolean) noexcept :
-        m_env(nullptr),
         m_type(type::boolean),
         m_data(std::bit_cast<object_data>(a_boolean))
     {}
 
     object::object(integer const a_integer) noexcept :
-        m_env(nullptr),
         m_type(type::integer),
         m_data(std::bit_cast<object_data>(a_integer))
     {}
 
     template <std::integral t_integer>
     object::object(t_integer a_integer) noexcept :
-        m_env(nullptr),
         m_type(type::integer),
         m_data(std::bit_cast<object_data>(static_cast<integer>(a_integer)))
     {}
 
     object::object(number const a_number) noexcept :
-        m_env(nullptr),
         m_type(type::number),
         m_data(std::bit_cast<object_data>(a_number))
     {}
 
     object::object(string const & a_string) noexcept :
-        m_env(a_string.m_engine),
         m_type(type::string),
         m_data(std::bit_cast<object_data>(a_string.m_container))
     {
@@ -144,19 +386,22 @@ namespace rebar {
     }
 
     object::object(string && a_string) noexcept :
-        m_env(a_string.m_engine),
         m_type(type::string),
         m_data(std::bit_cast<object_data>(a_string.m_container))
     {
         a_string.m_container = nullptr;
     }
 
+    object::object(type const a_type, object_data const a_data) noexcept :
+        m_type(a_type),
+        m_data(a_data)
+    {}
+
     object::~object() noexcept {
         dereference_object(this);
     }
 
     object::object(object const & a_object) noexcept :
-        m_env(a_object.m_env),
         m_type(a_object.m_type),
         m_data(a_object.m_data)
     {
@@ -164,7 +409,6 @@ namespace rebar {
     }
 
     object::object(object && a_object) noexcept :
-        m_env(a_object.m_env),
         m_type(a_object.m_type),
         m_data(a_object.m_data)
     {
@@ -176,6 +420,8 @@ namespace rebar {
     }
 
     object & object::operator = (boolean const a_boolean) noexcept {
+        dereference_object(this);
+
         m_type = type::boolean;
         m_data = std::bit_cast<object_data>(a_boolean);
 
@@ -183,6 +429,8 @@ namespace rebar {
     }
 
     object & object::operator = (integer const a_integer) noexcept {
+        dereference_object(this);
+
         m_type = type::integer;
         m_data = std::bit_cast<object_data>(a_integer);
 
@@ -191,6 +439,8 @@ namespace rebar {
 
     template <std::integral t_integer>
     object & object::operator = (t_integer a_integer) noexcept {
+        dereference_object(this);
+
         m_type = type::integer;
         m_data = std::bit_cast<object_data>(static_cast<integer>(a_integer));
 
@@ -198,6 +448,8 @@ namespace rebar {
     }
 
     object & object::operator = (number const a_number) noexcept {
+        dereference_object(this);
+
         m_type = type::number;
         m_data = std::bit_cast<object_data>(a_number);
 
@@ -205,7 +457,10 @@ namespace rebar {
     }
 
     object & object::operator = (string const & a_string) noexcept {
-        m_env = a_string.m_engine;
+        // Reference the new string before releasing the previous value.
+        a_string.m_container->reference();
+        dereference_object(this);
+
         m_type = type::string;
         m_data = std::bit_cast<object_data>(a_string.m_container);
 
@@ -213,7 +468,8 @@ namespace rebar {
     }
 
     object & object::operator = (string && a_string) noexcept {
-        m_env = a_string.m_engine;
+        dereference_object(this);
+
         m_type = type::string;
         m_data = std::bit_cast<object_data>(a_string.m_container);
 
@@ -227,26 +483,36 @@ namespace rebar {
             return *this;
         }
 
-        m_env = a_object.m_env;
+        // Reference the new value before releasing the previous value, as
+        // the previous value may own the new one.
+        reference_object(&a_object);
+        dereference_object(this);
+
         m_type = a_object.m_type;
         m_data = a_object.m_data;
 
-        reference_object(this);
-
         return *this;
     }
 
     object & object::operator = (object && a_object) noexcept {
-        m_env = a_object.m_env;
-        m_type = a_object.m_type;
-        m_data = a_object.m_data;
+        if (this == &a_object) {
+            return *this;
+        }
+
+        auto const transferred_type = a_object.m_type;
+        auto const transferred_data = a_object.m_data;
 
         // If transferred object is complex, make old object null.
-        if (type_integer() >= complex_type_threshold) {
+        if (a_object.type_integer() >= complex_type_threshold) {
             a_object.m_type = type::null;
             a_object.m_data = 0;
         }
 
+        dereference_object(this);
+
+        m_type = transferred_type;
+        m_data = transferred_data;
+
         return *this;
     }
 
@@ -262,6 +528,10 @@ namespace rebar {
         return is_type(type::null);
     }
 
+    bool object::is_boolean() const noexcept {
+        return is_type(type::boolean);
+    }
+
     bool object::is_integer() const noexcept {
         return is_type(type::integer);
     }
@@ -290,6 +560,39 @@ namespace rebar {
         return is_type(type::native);
     }
 
+    boolean object::get_boolean() const noexcept {
+        return std::bit_cast<boolean>(m_data);
+    }
+
+    integer object::get_integer() const noexcept {
+        return std::bit_cast<integer>(m_data);
+    }
+
+    number object::get_number() const noexcept {
+        return std::bit_cast<number>(m_data);
+    }
+
+    string object::get_string() const noexcept {
+        return string(as_internal_string());
+    }
+
+    std::string_view object::string_view() const noexcept {
+        return as_internal_string()->string;
+    }
+
+    bool object::identical(object const & a_object) const noexcept {
+        return m_type == a_object.m_type && m_data == a_object.m_data;
+    }
+
+    bool object::is_frozen() const noexcept {
+        // Every payload header starts with its reference count.
+        return type_integer() >= complex_type_threshold && *std::bit_cast<std::size_t const *>(m_data) == immortal_reference_count;
+    }
+
+    object object::call(std::initializer_list<object> const a_arguments) const {
+        return call(std::span(a_arguments.begin(), a_arguments.size()));
+    }
+
     std::size_t object::type_integer() const noexcept {
         return static_cast<std::size_t>(m_type);
     }
@@ -298,6 +601,22 @@ namespace rebar {
         return std::bit_cast<internal_string *>(m_data);
     }
 
+    internal_array * object::as_internal_array() const noexcept {
+        return std::bit_cast<internal_array *>(m_data);
+    }
+
+    internal_function * object::as_internal_function() const noexcept {
+        return std::bit_cast<internal_function *>(m_data);
+    }
+
+    internal_table * object::as_internal_table() const noexcept {
+        return std::bit_cast<internal_table *>(m_data);
+    }
+
+    internal_native * object::as_internal_native() const noexcept {
+        return std::bit_cast<internal_native *>(m_data);
+    }
+
 }
 
 #endif //OBJECT_HPP
@@ -0,0 +1,188 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef OPERATIONS_HPP
+#define OPERATIONS_HPP
+
+#include <array>
+
+#include <rebar/environment/object.hpp>
+#include <rebar/semantic_analysis/operators.hpp>
+
+namespace rebar {
+
+    /**
+     * Operations performed on pairs of objects through the type-pair
+     * dispatch matrix, in matrix order.
+     */
+    constexpr std::array dispatched_operations{
+        operation::addition,
+        operation::subtraction,
+        operation::multiplication,
+        operation::division,
+        operation::exponentiation,
+        operation::modulo,
+        operation::bitwise_and,
+        operation::bitwise_or,
+        operation::bitwise_xor,
+        operation::equality,
+        operation::lesser,
+        operation::lesser_equality,
+        operation::greater,
+        operation::greater_equality,
+    };
+
+    /// Amount of operations in the dispatch matrix.
+    constexpr std::size_t dispatched_operation_count = dispatched_operations.size();
+
+    /**
+     * A handler performing an operation on a specific pair of object types.
+     * @param a_lhs The left-hand operand.
+     * @param a_rhs The right-hand operand.
+     * @return The result of the operation.
+     */
+    using operation_handler = object (*)(object const & a_lhs, object const & a_rhs);
+
+    /**
+     * Find the index of an operation in the dispatch matrix.
+     * @param a_operation The operation of which to find the index.
+     * @return The index of the operation, or dispatched_operation_count if the
+     *         operation is not dispatched through the matrix.
+     */
+    constexpr std::size_t dispatched_operation_index(operation const a_operation) noexcept {
+        for (std::size_t i = 0; i < dispatched_operation_count; ++i) {
+            if (dispatched_operations[i] == a_operation) {
+                return i;
+            }
+        }
+
+        return dispatched_operation_count;
+    }
+
+    /**
+     * Retrieve the handler of an operation for a pair of object types from
+     * the dispatch matrix.
+     * @param a_operation_index The index of the operation (see
+     *                          dispatched_operation_index()).
+     * @param a_lhs The type of the left-hand operand.
+     * @param a_rhs The type of the right-hand operand.
+     * @return The handler of the operation for the type pair.
+     */
+    [[nodiscard]]
+    operation_handler operation_dispatch(std::size_t a_operation_index, type a_lhs, type a_rhs) noexcept;
+
+    /**
+     * Perform an operation on a pair of objects.
+     *
+     * Integer arithmetic that overflows produces a number (floating point)
+     * result, as does division. Operations that are not defined for the
+     * operand types throw std::invalid_argument; integer modulo by zero
+     * throws std::domain_error.
+     * @param a_operation The operation to perform. Must be one of the
+     *                    dispatched_operations.
+     * @param a_lhs The left-hand operand.
+     * @param a_rhs The right-hand operand.
+     * @return The result of the operation.
+     */
+    [[nodiscard]]
+    object perform_operation(operation a_operation, object const & a_lhs, object const & a_rhs);
+
+    /**
+     * Perform an operation known at compile time on a pair of objects. The
+     * common integer and number type pairs are handled inline; all other
+     * pairs go through the dispatch matrix.
+     * @tparam v_operation The operation to perform. Must be one of the
+     *                     dispatched_operations.
+     * @param a_lhs The left-hand operand.
+     * @param a_rhs The right-hand operand.
+     * @return The result of the operation.
+     */
+    template <operation v_operation>
+    [[nodiscard]]
+    inline object perform_operation(object const & a_lhs, object const & a_rhs);
+
+    // ###################################### INLINE DEFINITIONS ######################################
+
+    template <operation v_operation>
+    object perform_operation(object const & a_lhs, object const & a_rhs) {
+        constexpr auto operation_index = dispatched_operation_index(v_operation);
+
+        static_assert(operation_index != dispatched_operation_count, "Operation is not dispatched on object pairs.");
+
+        if (a_lhs.is_integer() && a_rhs.is_integer()) [[likely]] {
+            integer const lhs = a_lhs.get_integer();
+            integer const rhs = a_rhs.get_integer();
+
+            [[maybe_unused]] integer result;
+
+            if constexpr (v_operation == operation::addition) {
+                if (!__builtin_add_overflow(lhs, rhs, &result)) [[likely]] {
+                    return object(result);
+                }
+            }
+            else if constexpr (v_operation == operation::subtraction) {
+                if (!__builtin_sub_overflow(lhs, rhs, &result)) [[likely]] {
+                    return object(result);
+                }
+            }
+            else if constexpr (v_operation == operation::multiplication) {
+                if (!__builtin_mul_overflow(lhs, rhs, &result)) [[likely]] {
+                    return object(result);
+                }
+            }
+            else if constexpr (v_operation == operation::equality) {
+                return object(lhs == rhs ? _true : _false);
+            }
+            else if constexpr (v_operation == operation::lesser) {
+                return object(lhs < rhs ? _true : _false);
+            }
+            else if constexpr (v_operation == operation::lesser_equality) {
+                return object(lhs <= rhs ? _true : _false);
+            }
+            else if constexpr (v_operation == operation::greater) {
+                return object(lhs > rhs ? _true : _false);
+            }
+            else if constexpr (v_operation == operation::greater_equality) {
+                return object(lhs >= rhs ? _true : _false);
+            }
+        }
+        else if (a_lhs.is_number() && a_rhs.is_number()) {
+            number const lhs = a_lhs.get_number();
+            number const rhs = a_rhs.get_number();
+
+            if constexpr (v_operation == operation::addition) {
+                return object(lhs + rhs);
+            }
+            else if constexpr (v_operation == operation::subtraction) {
+                return object(lhs - rhs);
+            }
+            else if constexpr (v_operation == operation::multiplication) {
+                return object(lhs * rhs);
+            }
+            else if constexpr (v_operation == operation::division) {
+                return object(lhs / rhs);
+            }
+            else if constexpr (v_operation == operation::equality) {
+                return object(lhs == rhs ? _true : _false);
+            }
+            else if constexpr (v_operation == operation::lesser) {
+                return object(lhs < rhs ? _true : _false);
+            }
+            else if constexpr (v_operation == operation::lesser_equality) {
+                return object(lhs <= rhs ? _true : _false);
+            }
+            else if constexpr (v_operation == operation::greater) {
+                return object(lhs > rhs ? _true : _false);
+            }
+            else if constexpr (v_operation == operation::greater_equality) {
+                return object(lhs >= rhs ? _true : _false);
+            }
+        }
+
+        return operation_dispatch(operation_index, a_lhs.object_type(), a_rhs.object_type())(a_lhs, a_rhs);
+    }
+
+}
+
+#endif //OPERATIONS_HPP
@@ -0,0 +1,64 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef SERIALIZATION_HPP
+#define SERIALIZATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <rebar/environment/object.hpp>
+
+namespace rebar {
+
+    /*
+     * Binary Object Graph Format: A graph of tables, arrays, strings and
+     * simple values, laid out so that string characters and typed arrays
+     * load without copying (see frozen_graph::load).
+     *
+     * All fields are 64-bit words in native byte order and every section is
+     * aligned to 8 bytes. Values are encoded as a type word and a data word;
+     * the data word of a simple value is its raw data, that of a string is
+     * an index into the string table, and that of an array or table is the
+     * offset of its node.
+     *
+     * - Strings: Every distinct string is stored once. The string table
+     *   holds the offset and length of the characters of every string.
+     * - Arrays: An array node holds its storage kind and length, followed by
+     *   its elements. Arrays of only integers or only numbers are stored as
+     *   raw 64-bit values; all other arrays as encoded values.
+     * - Tables: A table node holds the index of its shape (the sorted keys of
+     *   the table, shared by all tables with the same keys) and its entry
+     *   count, followed by its values (slots) in shape order.
+     */
+
+    /// Magic number at the start of serialized object graphs ("RBRG").
+    constexpr std::uint32_t graph_magic = 0x47524252;
+
+    /// Version of the binary object graph format.
+    constexpr std::uint32_t graph_format_version = 1;
+
+    /**
+     * Serialize an object graph into the binary object graph format.
+     * @param a_object The root of the graph to serialize.
+     * @return The serialized graph.
+     * @note Throws std::invalid_argument if the graph contains functions or
+     *       natives. Cyclic graphs are not supported.
+     */
+    [[nodiscard]]
+    std::vector<std::byte> serialize_graph(object const & a_object);
+
+    /**
+     * Serialize an object graph into a file (see serialize_graph()).
+     * @param a_object The root of the graph to serialize.
+     * @param a_path The path of the file to write.
+     * @note Throws std::runtime_error if the file cannot be written.
+     */
+    void write_graph(object const & a_object, std::filesystem::path const & a_path);
+
+}
+
+#endif //SERIALIZATION_HPP
@@ -0,0 +1,453 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef TABLE_HPP
+#define TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <vector>
+
+#include <rebar/environment/object.hpp>
+#include <rebar/memory/pool_allocator.hpp>
+
+namespace rebar {
+
+    /**
+     * An entry of a compact table. Removed entries are left in place as
+     * tombstones (null keys) until the table is next resized.
+     */
+    struct table_entry {
+        std::size_t hash; ///< Hash of the key (see table_mode).
+        object      key;
+        object      value;
+    };
+
+    /**
+     * How a table holds the objects of its entries.
+     *
+     * Weak tables do not keep their weakly held arrays, tables, functions and
+     * natives alive: once such an object is destroyed, the entries holding
+     * it are removed. Strings and simple values are always held strongly, as
+     * are frozen objects, which are never destroyed.
+     *
+     * Weak-key tables compare and hash their weakly held keys by identity,
+     * since the only strong owner of such a key may modify it in place.
+     */
+    enum class table_mode : std::uint8_t {
+        strong,      ///< Keys and values are held strongly.
+        weak_keys,   ///< Keys are held weakly.
+        weak_values, ///< Values are held weakly.
+    };
+
+    /// A reference to the key and value of an entry of a compact table.
+    struct table_entry_reference {
+        object const & key;
+        object const & value;
+    };
+
+    /**
+     * An insertion-ordered hash table of objects with a dense array part.
+     *
+     * Entries keyed by the integers 0, 1, 2, ... are stored by position in
+     * an array part, so looking them up is a bounds check and an indexed
+     * load. Absent keys in the array part are held as null.
+     *
+     * All other entries are stored densely in insertion order in the hash
+     * part, and a separate open addressing index maps hash slots to entry
+     * positions. Index slots are 8, 16 or 32 bits wide depending on the
+     * capacity of the table, so small tables stay small, and iteration is a
+     * linear scan of the array part and then the entries.
+     *
+     * Weak-value tables store every entry in the hash part, so that each
+     * weakly held value can be found from the hash of its key.
+     */
+    class compact_table {
+        std::pmr::vector<object>      m_elements;          ///< The array part.
+        std::size_t                   m_element_count = 0; ///< Amount of non-null elements.
+        std::pmr::vector<table_entry> m_entries;
+
+        std::pmr::memory_resource * m_resource;
+        void *                      m_index          = nullptr;
+        std::size_t                 m_index_capacity = 0; ///< Amount of index slots (a power of two, or zero).
+        std::size_t                 m_index_width    = 0; ///< Size of each index slot in bytes.
+        std::size_t                 m_size           = 0; ///< Amount of live (non-tombstone) entries in the hash part.
+        table_mode                  m_mode           = table_mode::strong;
+
+    public:
+        /**
+         * Iterates the live entries of a table: the array part in key order,
+         * followed by the hash part in insertion order.
+         */
+        class const_iterator {
+            compact_table const * m_table    = nullptr;
+            std::size_t           m_position = 0; ///< Position in the array part, then in the entries.
+            object                m_key;          ///< Key of the current element of the array part.
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type        = table_entry_reference;
+            using difference_type   = std::ptrdiff_t;
+            using reference         = table_entry_reference;
+
+            const_iterator() noexcept = default;
+
+            inline const_iterator(compact_table const & a_table, std::size_t a_position) noexcept;
+
+            [[nodiscard]]
+            inline reference operator * () const noexcept;
+
+            inline const_iterator & operator ++ () noexcept;
+            inline const_iterator operator ++ (int) noexcept;
+
+            [[nodiscard]]
+            inline bool operator == (const_iterator const & a_iterator) const noexcept;
+
+        private:
+            inline void skip_tombstones() noexcept;
+        };
+
+        /**
+         * Construct an empty table.
+         * @param a_resource The memory resource from which to allocate the
+         *                   entries and index.
+         */
+        inline explicit compact_table(std::pmr::memory_resource * a_resource = std::pmr::get_default_resource()) noexcept;
+
+        /**
+         * Construct an empty table holding its entries in a mode.
+         * @param a_mode How the table holds its entries.
+         * @param a_resource The memory resource from which to allocate the
+         *                   entries and index.
+         */
+        inline explicit compact_table(table_mode a_mode, std::pmr::memory_resource * a_resource = std::pmr::get_default_resource()) noexcept;
+
+        /**
+         * Construct an empty table with room for a number of entries.
+         * @param a_reserve The amount of entries to reserve room for.
+         * @param a_resource The memory resource from which to allocate the
+         *                   entries and index.
+         */
+        explicit compact_table(std::size_t a_reserve, std::pmr::memory_resource * a_resource = std::pmr::get_default_resource());
+
+        /**
+         * Copy the live entries of a table, in order, into a new table.
+         * Creates a new reference to every key and value.
+         */
+        compact_table(compact_table const & a_table, std::pmr::memory_resource * a_resource = std::pmr::get_default_resource());
+
+        compact_table(compact_table && a_table) noexcept;
+
+        ~compact_table() noexcept;
+
+        compact_table & operator = (compact_table const &) = delete;
+        compact_table & operator = (compact_table &&)      = delete;
+
+        /**
+         * Retrieve the amount of live entries.
+         * @return The amount of entries in the table.
+         */
+        [[nodiscard]]
+        inline std::size_t size() const noexcept;
+
+        /**
+         * Retrieve how the table holds its entries.
+         * @return The mode of the table.
+         */
+        [[nodiscard]]
+        inline table_mode mode() const noexcept;
+
+        /**
+         * Retrieve the length of the array part, including absent keys.
+         * @return The length of the array part.
+         */
+        [[nodiscard]]
+        inline std::size_t array_part_length() const noexcept;
+
+        /**
+         * Retrieve the width of each index slot in bytes (1, 2 or 4), or zero
+         * if no index is allocated.
+         * @return The width of the index slots.
+         */
+        [[nodiscard]]
+        inline std::size_t index_width() const noexcept;
+
+        /**
+         * Find the value of an entry.
+         * @param a_key The key of the entry.
+         * @return A pointer to the value, or nullptr if there is no such entry.
+         */
+        [[nodiscard]]
+        object const * find(object const & a_key) const;
+
+        /**
+         * Assign the value of an entry, appending a new entry if the key is
+         * not yet present.
+         * @param a_key The key of the entry. Must not be null.
+         * @param a_value The value of the entry.
+         */
+        void insert_or_assign(object a_key, object a_value);
+
+        /**
+         * Remove an entry.
+         * @param a_key The key of the entry.
+         * @return True if an entry was removed.
+         */
+        bool erase(object const & a_key);
+
+        /**
+         * Reserve room for a number of entries in the hash part without
+         * resizing.
+         * @param a_reserve The amount of entries.
+         */
+        void reserve(std::size_t a_reserve);
+
+        [[nodiscard]]
+        inline const_iterator begin() const noexcept;
+
+        [[nodiscard]]
+        inline const_iterator end() const noexcept;
+
+    private:
+        /// Marks an index slot that has never been used.
+        static constexpr std::size_t empty_slot = SIZE_MAX;
+
+        /// Marks an index slot of a removed entry.
+        static constexpr std::size_t removed_slot = SIZE_MAX - 1;
+
+        /**
+         * Find the position in the array part that a key may occupy.
+         * @return The position, or SIZE_MAX if the key is not a non-negative
+         *         integer (or integral number).
+         */
+        [[nodiscard]]
+        static std::size_t element_position(object const & a_key) noexcept;
+
+        /**
+         * Find the position in the array part that a key may occupy in this
+         * table, which is SIZE_MAX for every key of a weak-value table.
+         */
+        [[nodiscard]]
+        inline std::size_t array_position(object const & a_key) const noexcept;
+
+        /**
+         * Hash a key of this table: structurally, or by identity if the key
+         * is held weakly.
+         */
+        [[nodiscard]]
+        std::size_t key_hash(object const & a_key) const;
+
+        /**
+         * Compare a key of this table with another key: structurally, or by
+         * identity if either key is held weakly.
+         */
+        [[nodiscard]]
+        bool keys_equal(object const & a_entry_key, object const & a_key) const;
+
+        /**
+         * Retrieve the component of an entry that the table holds weakly.
+         */
+        [[nodiscard]]
+        inline object & weak_component(table_entry & a_entry) const noexcept;
+
+        /**
+         * Test if an object can be held weakly: arrays, tables, functions
+         * and natives that are not frozen.
+         */
+        [[nodiscard]]
+        static bool weakly_holdable(object const & a_component) noexcept;
+
+        /**
+         * Test if an object would be destroyed as soon as it was held weakly,
+         * as the reference being given up is its only one.
+         */
+        [[nodiscard]]
+        static bool held_only_here(object const & a_component) noexcept;
+
+        /**
+         * Give up the reference the table holds to a weak component of an
+         * entry, registering the entry to be removed once the object is
+         * destroyed.
+         */
+        void hold_weakly(object const & a_component, std::size_t a_hash) noexcept;
+
+        /**
+         * Reacquire the reference to a weak component before the component
+         * is released along with its entry.
+         */
+        void release_weak(object const & a_component, std::size_t a_hash) noexcept;
+
+        /**
+         * Remove the entry weakly holding an object that is being destroyed,
+         * without releasing that object.
+         */
+        void remove_weak(void const * a_referent, std::size_t a_hash) noexcept;
+
+        friend void release_weak_references(void const * a_referent) noexcept;
+
+        /**
+         * Append an element to the array part, then move the entries of the
+         * following keys from the hash part to the array part.
+         */
+        void append_element(object a_value);
+
+        /**
+         * Remove an entry from the hash part.
+         * @return The removed value, or null if there is no such entry.
+         */
+        object erase_entry(object const & a_key, std::size_t a_hash);
+
+        [[nodiscard]]
+        std::size_t slot_value(std::size_t a_slot) const noexcept;
+
+        void set_slot_value(std::size_t a_slot, std::size_t a_value) noexcept;
+
+        /**
+         * Find the index slot that refers to an entry.
+         * @return The slot, or empty_slot if there is no such entry.
+         */
+        [[nodiscard]]
+        std::size_t find_slot(object const & a_key, std::size_t a_hash) const;
+
+        /**
+         * Point the first empty index slot along the probe sequence of an
+         * entry to that entry.
+         */
+        void link(std::size_t a_position) noexcept;
+
+        /**
+         * Remove tombstones and rebuild the index with room for at least the
+         * requested amount of entries.
+         */
+        void rebuild(std::size_t a_capacity);
+
+        void release_index() noexcept;
+    };
+
+    /**
+     * Remove the entries of weak tables that weakly hold an object. Called
+     * before the payload of an array, table, function or native is
+     * destroyed.
+     * @param a_referent The payload being destroyed.
+     */
+    void release_weak_references(void const * a_referent) noexcept;
+
+    /**
+     * The payload of a table object. Table payloads are allocated from the
+     * pool allocator of the environment that created them, or from the arena
+     * of a frozen graph.
+     */
+    struct internal_table {
+        std::size_t      reference_count;
+        pool_allocator * allocator; ///< Allocator of the payload (null if frozen).
+        compact_table    entries;
+
+        std::size_t hash        = 0;     ///< Memoized structural hash.
+        bool        hash_cached = false; ///< Whether the memoized hash is valid.
+    };
+
+    // ###################################### INLINE DEFINITIONS ######################################
+
+    compact_table::const_iterator::const_iterator(compact_table const & a_table, std::size_t const a_position) noexcept :
+        m_table(&a_table),
+        m_position(a_position)
+    {
+        skip_tombstones();
+    }
+
+    compact_table::const_iterator::reference compact_table::const_iterator::operator * () const noexcept {
+        auto const element_count = m_table->m_elements.size();
+
+        if (m_position < element_count) {
+            return { m_key, m_table->m_elements[m_position] };
+        }
+
+        auto const & entry = m_table->m_entries[m_position - element_count];
+        return { entry.key, entry.value };
+    }
+
+    compact_table::const_iterator & compact_table::const_iterator::operator ++ () noexcept {
+        ++m_position;
+        skip_tombstones();
+
+        return *this;
+    }
+
+    compact_table::const_iterator compact_table::const_iterator::operator ++ (int) noexcept {
+        auto const previous = *this;
+        ++*this;
+
+        return previous;
+    }
+
+    bool compact_table::const_iterator::operator == (const_iterator const & a_iterator) const noexcept {
+        return m_position == a_iterator.m_position;
+    }
+
+    void compact_table::const_iterator::skip_tombstones() noexcept {
+        auto const & elements = m_table->m_elements;
+        auto const & entries = m_table->m_entries;
+
+        while (m_position < elements.size() && elements[m_position].is_null()) {
+            ++m_position;
+        }
+
+        if (m_position < elements.size()) {
+            m_key = static_cast<integer>(m_position);
+            return;
+        }
+
+        while (m_position - elements.size() < entries.size() && entries[m_position - elements.size()].key.is_null()) {
+            ++m_position;
+        }
+    }
+
+    compact_table::compact_table(std::pmr::memory_resource * const a_resource) noexcept :
+        compact_table(table_mode::strong, a_resource)
+    {}
+
+    compact_table::compact_table(table_mode const a_mode, std::pmr::memory_resource * const a_resource) noexcept :
+        m_elements(a_resource),
+        m_entries(a_resource),
+        m_resource(a_resource),
+        m_mode(a_mode)
+    {}
+
+    table_mode compact_table::mode() const noexcept {
+        return m_mode;
+    }
+
+    std::size_t compact_table::size() const noexcept {
+        return m_element_count + m_size;
+    }
+
+    std::size_t compact_table::array_part_length() const noexcept {
+        return m_elements.size();
+    }
+
+    std::size_t compact_table::index_width() const noexcept {
+        return m_index_width;
+    }
+
+    std::size_t compact_table::array_position(object const & a_key) const noexcept {
+        return m_mode == table_mode::weak_values ? SIZE_MAX : element_position(a_key);
+    }
+
+    object & compact_table::weak_component(table_entry & a_entry) const noexcept {
+        return m_mode == table_mode::weak_keys ? a_entry.key : a_entry.value;
+    }
+
+    compact_table::const_iterator compact_table::begin() const noexcept {
+        return { *this, 0 };
+    }
+
+    compact_table::const_iterator compact_table::end() const noexcept {
+        return { *this, m_elements.size() + m_entries.size() };
+    }
+
+}
+
+#endif //TABLE_HPP
@@ -5,7 +5,9 @@
 #ifndef TYPES_HPP
 #define TYPES_HPP
 
+#include <array>
 #include <cstdint>
+#include <string_view>
 
 namespace rebar {
 
@@ -53,6 +55,25 @@ namespace rebar {
                        */
     };
 
+    /// Amount of Rebar object types.
+    constexpr std::size_t type_count = static_cast<std::size_t>(type::native) + 1;
+
+    constexpr std::string_view type_as_string(type const a_type) noexcept {
+        constexpr std::array type_strings{
+            "null",
+            "boolean",
+            "integer",
+            "number",
+            "string",
+            "function",
+            "table",
+            "array",
+            "native",
+        };
+
+        return type_strings[static_cast<std::size_t>(a_type)];
+    }
+
     /**
      * Type integer threshold for complex types. All types with an integer
      * equal to or greater than this value are complex types.
@@ -0,0 +1,74 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef CHARACTER_CLASS_HPP
+#define CHARACTER_CLASS_HPP
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace rebar {
+
+    /**
+     * Character classes used by the lexical analyzer. A character may belong
+     * to several classes at once (digits both continue identifiers and begin
+     * numbers).
+     */
+    enum class character_class : std::uint8_t {
+        none                = 0,
+        digit               = 1 << 0, ///< 0-9.
+        identifier_start    = 1 << 1, ///< a-z, A-Z and _.
+        identifier_continue = 1 << 2, ///< a-z, A-Z, 0-9 and _.
+        whitespace          = 1 << 3, ///< Space, tab, newline and carriage return.
+    };
+
+    constexpr character_class operator | (character_class const a_lhs, character_class const a_rhs) noexcept {
+        return static_cast<character_class>(static_cast<std::uint8_t>(a_lhs) | static_cast<std::uint8_t>(a_rhs));
+    }
+
+    /**
+     * Lookup table mapping every byte to its character classes. Independent
+     * of the current locale; bytes outside of ASCII belong to no class.
+     */
+    constexpr std::array<std::uint8_t, 256> character_class_table = [] {
+        std::array<std::uint8_t, 256> table{};
+
+        auto const add = [&table](unsigned char const a_char, character_class const a_class) {
+            table[a_char] |= static_cast<std::uint8_t>(a_class);
+        };
+
+        for (unsigned char c = '0'; c <= '9'; ++c) {
+            add(c, character_class::digit | character_class::identifier_continue);
+        }
+
+        for (unsigned char c = 'a'; c <= 'z'; ++c) {
+            add(c, character_class::identifier_start | character_class::identifier_continue);
+            add(c - 'a' + 'A', character_class::identifier_start | character_class::identifier_continue);
+        }
+
+        add('_', character_class::identifier_start | character_class::identifier_continue);
+
+        for (unsigned char const c : std::string_view(" \t\n\r")) {
+            add(c, character_class::whitespace);
+        }
+
+        return table;
+    }();
+
+    /**
+     * Test if a character belongs to a character class.
+     * @param a_char The character to test.
+     * @param a_class The class to test for (or a union of classes, in which
+     *                case membership of any one suffices).
+     * @return Whether the character belongs to the class.
+     */
+    [[nodiscard]]
+    constexpr bool is_character_class(unsigned char const a_char, character_class const a_class) noexcept {
+        return (character_class_table[a_char] & static_cast<std::uint8_t>(a_class)) != 0;
+    }
+
+}
+
+#endif //CHARACTER_CLASS_HPP
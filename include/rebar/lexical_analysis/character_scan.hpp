@@ -0,0 +1,53 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef CHARACTER_SCAN_HPP
+#define CHARACTER_SCAN_HPP
+
+#include <cstdint>
+
+namespace rebar {
+
+    /// Instruction sets for which character scanners are implemented.
+    enum class scan_isa : std::uint8_t {
+        scalar, ///< Portable, one byte at a time.
+        sse2,   ///< 16 bytes at a time (x86-64).
+        avx2,   ///< 32 bytes at a time (x86-64 with AVX2).
+    };
+
+    /**
+     * A set of functions finding the end of runs of characters. Each
+     * function returns a pointer to the first character in [a_begin, a_end)
+     * that does not belong to the run, or a_end.
+     */
+    struct character_scanner {
+        using scan_function = char const * (*)(char const * a_begin, char const * a_end) noexcept;
+
+        scan_isa      isa;
+        scan_function skip_whitespace; ///< Runs of whitespace.
+        scan_function skip_identifier; ///< Runs of identifier-continue characters.
+        scan_function skip_number;     ///< Runs of digits, decimal points and separators (').
+        scan_function skip_string;     ///< Runs of string literal content (anything but " and \).
+        scan_function skip_line;       ///< Runs of characters other than line feeds.
+    };
+
+    /**
+     * Get the fastest character scanner supported by the executing CPU. The
+     * selection is made once, on first use.
+     */
+    [[nodiscard]]
+    character_scanner const & default_character_scanner() noexcept;
+
+    /**
+     * Get the character scanner for a specific instruction set.
+     * @param a_isa The instruction set.
+     * @return The scanner, or nullptr if the instruction set is not
+     *         available in this build or on the executing CPU.
+     */
+    [[nodiscard]]
+    character_scanner const * character_scanner_for(scan_isa a_isa) noexcept;
+
+}
+
+#endif //CHARACTER_SCAN_HPP
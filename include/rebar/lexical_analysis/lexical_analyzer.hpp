@@ -6,28 +6,57 @@
 #define LEXICAL_ANALYZER_HPP
 
 #include <ranges>
+#include <span>
 
 #include <rebar/lexical_analysis/symbol.hpp>
+#include <rebar/lexical_analysis/symbol_trie.hpp>
 #include <rebar/lexical_analysis/lexical_unit.hpp>
 #include <rebar/lexical_analysis/escape_sequence.hpp>
 
 namespace rebar {
 
+    class token_ring;
+
     /**
      * A class to analyze and convert plaintext to lexical tokens.
      */
     class lexical_analyzer {
         string_engine*      m_string_engine;
-        symbol_map          m_symbol_map;
+        symbol_trie         m_symbol_trie;
         escape_sequence_map m_escape_sequence_map;
-        std::size_t         m_max_symbol_length;
 
     public:
+        /**
+         * Construct an analyzer matching symbols with a prebuilt trie.
+         * @param a_string_engine The engine in which to intern identifiers
+         *                        and strings.
+         * @param a_symbol_trie The symbols to recognize. Defaults to the
+         *                      default Rebar symbol set, whose trie is
+         *                      generated at compile time.
+         * @param a_escape_sequence_map The escape sequences to recognize.
+         */
         explicit inline lexical_analyzer(
             string_engine & a_string_engine,
-            symbol_map a_symbol_map = default_symbol_map(),
+            symbol_trie a_symbol_trie = default_symbol_trie(),
+            escape_sequence_map a_escape_sequence_map = default_escape_sequence_map()
+        );
+
+        /**
+         * Construct an analyzer recognizing the symbols of a runtime symbol
+         * map.
+         * @param a_string_engine The engine in which to intern identifiers
+         *                        and strings.
+         * @param a_symbol_map The symbols to recognize. Symbols may begin
+         *                     with any character, but whitespace, string
+         *                     literals and numeric literals take precedence
+         *                     over symbols they begin.
+         * @param a_escape_sequence_map The escape sequences to recognize.
+         */
+        inline lexical_analyzer(
+            string_engine & a_string_engine,
+            symbol_map const & a_symbol_map,
             escape_sequence_map a_escape_sequence_map = default_escape_sequence_map()
-        ) noexcept;
+        );
 
         lexical_analyzer(lexical_analyzer const &) noexcept = default;
         lexical_analyzer(lexical_analyzer &&)      noexcept = default;
@@ -43,6 +72,68 @@ namespace rebar {
          */
         void perform_analysis(lexical_unit & a_lexical_unit) const;
 
+        /**
+         * Perform lexical analysis on the plaintext in the lexical unit,
+         * dividing it between several threads. The result is identical to
+         * that of perform_analysis().
+         *
+         * The plaintext is split into chunks at line boundaries, and each
+         * chunk is speculatively analyzed from a guess of whether it begins
+         * inside a string literal. Chunks are then joined in order; where
+         * the previous chunk did not end exactly at the beginning of the
+         * next, analysis continues sequentially until a token begins at the
+         * position of a speculatively analyzed one, from which the
+         * speculative tokens are taken.
+         * @param a_lexical_unit The lexical unit containing the text to
+         *                       examine and in which the results of the
+         *                       analysis will be placed.
+         * @param a_thread_count The maximum amount of threads to use,
+         *                       including the calling thread, or zero to
+         *                       use the hardware concurrency.
+         */
+        void perform_parallel_analysis(lexical_unit & a_lexical_unit, std::size_t a_thread_count = 0) const;
+
+        /**
+         * Edit the plaintext of an analyzed lexical unit, analyzing only the
+         * region affected by the edit.
+         *
+         * Analysis resumes at a token early enough to be unaffected by the
+         * edit, and stops once a token begins after the edit at the (shifted)
+         * position of a token of the previous analysis, from which the
+         * previous tokens are kept. The result is identical to that of
+         * perform_analysis() on the edited plaintext.
+         * @param a_lexical_unit The analyzed lexical unit to edit.
+         * @param a_offset The position of the edit in the plaintext.
+         * @param a_removed_length The amount of characters removed at the
+         *                         position.
+         * @param a_inserted_text The text inserted at the position.
+         * @throws std::out_of_range If the removed characters exceed the
+         *                           plaintext.
+         * @note The lexical unit is unchanged if analysis throws.
+         */
+        void perform_incremental_analysis(
+            lexical_unit & a_lexical_unit,
+            std::size_t a_offset,
+            std::size_t a_removed_length,
+            std::string_view a_inserted_text
+        ) const;
+
+        /**
+         * Perform lexical analysis on a part of a larger plaintext, such as a
+         * chunk of streamed input.
+         * @param a_plaintext The part of the plaintext to examine.
+         * @param a_position The position of the part in the complete
+         *                   plaintext, added to the position of each token.
+         * @param a_final Whether the part ends the plaintext. If not,
+         *                analysis stops before any token that may continue
+         *                past the end of the part.
+         * @param a_tokens The ring buffer in which to place tokens. Analysis
+         *                 stops once it is full.
+         * @return The amount of characters of the part consumed. Analysis of
+         *         the plaintext resumes from this offset.
+         */
+        std::size_t perform_partial_analysis(std::string_view a_plaintext, std::size_t a_position, bool a_final, token_ring & a_tokens) const;
+
         /**
          * Replaces all occurrences of escape sequences (\?) with their
          * matching characters.
@@ -52,6 +143,17 @@ namespace rebar {
         [[nodiscard]]
         std::string process_string(std::string_view a_raw_string) const;
 
+        /**
+         * Replaces the escape sequences (\?) at known positions with their
+         * matching characters, without searching the string for them.
+         * @param a_raw_string The raw string with explicit escape sequences.
+         * @param a_escape_offsets The ascending offsets of the backslash
+         *                         beginning each escape sequence.
+         * @return The processed string, with escape string replaced.
+         */
+        [[nodiscard]]
+        std::string process_string(std::string_view a_raw_string, std::span<std::size_t const> a_escape_offsets) const;
+
         /**
          * Parse a string into a number.
          * @param a_raw_string The string to parse for a number.
@@ -60,6 +162,9 @@ namespace rebar {
          *                         true, separating characters will be removed
          *                         before final parsing.)
          * @return The parsed number.
+         * @throws std::invalid_argument If the string does not begin with
+         *                               a number.
+         * @throws std::out_of_range If the number is not representable.
          */
         [[nodiscard]]
         static number parse_number(std::string_view a_raw_string, bool a_has_separators = true);
@@ -72,32 +177,48 @@ namespace rebar {
          *                         true, separating characters will be removed
          *                         before final parsing.)
          * @return The parsed integer.
+         * @throws std::invalid_argument If the string does not begin with
+         *                               an integer.
+         * @throws std::out_of_range If the integer is not representable.
          */
         [[nodiscard]]
         static integer parse_integer(std::string_view a_raw_string, bool a_has_separators = true);
+
+    private:
+        /**
+         * Analyze plaintext, passing each token to a sink.
+         * @param a_plaintext The plaintext to examine.
+         * @param a_final Whether the plaintext ends the input (see
+         *                perform_partial_analysis()).
+         * @param a_sink Invoked with each token and its offset in the
+         *               plaintext. Returns false to stop analysis.
+         * @return The amount of characters consumed.
+         */
+        template <typename t_sink>
+        std::size_t analyze_plaintext(std::string_view a_plaintext, bool a_final, t_sink && a_sink) const;
     };
 
     // ###################################### INLINE DEFINITIONS ######################################
 
     lexical_analyzer::lexical_analyzer(
         string_engine & a_string_engine,
-        symbol_map a_symbol_map,
+        symbol_trie a_symbol_trie,
         escape_sequence_map a_escape_sequence_map
-    ) noexcept :
+    ) :
         m_string_engine(&a_string_engine),
-        m_symbol_map(std::move(a_symbol_map)),
+        m_symbol_trie(std::move(a_symbol_trie)),
         m_escape_sequence_map(std::move(a_escape_sequence_map))
-    {
-        // Find max symbol length for use in parsing with selecting symbols.
-        m_max_symbol_length = std::ranges::max(
-            std::ranges::views::keys(m_symbol_map) |
-            std::ranges::views::transform(
-                [](auto const & a) {
-                    return a.size();
-                }
-            )
-        );
-    }
+    {}
+
+    lexical_analyzer::lexical_analyzer(
+        string_engine & a_string_engine,
+        symbol_map const & a_symbol_map,
+        escape_sequence_map a_escape_sequence_map
+    ) :
+        m_string_engine(&a_string_engine),
+        m_symbol_trie(a_symbol_map),
+        m_escape_sequence_map(std::move(a_escape_sequence_map))
+    {}
 
 }
 
@@ -5,34 +5,139 @@
 #ifndef LEXICAL_UNIT_HPP
 #define LEXICAL_UNIT_HPP
 
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <memory>
 #include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <rebar/lexical_analysis/token.hpp>
 
 namespace rebar {
+    /// A line and column in a plaintext, both counted from one. Columns are counted in bytes.
+    struct plaintext_location {
+        std::size_t line   = 1;
+        std::size_t column = 1;
+
+        [[nodiscard]]
+        bool operator ==(plaintext_location const &) const noexcept = default;
+    };
+
     /**
      * A class to store lexical analysis data, output, and other related
      * information.
+     *
+     * Tokens are stored as a structure of arrays (types, untagged payloads
+     * and positions), so that scans over the token stream only touch the
+     * bytes they need. Token positions are 32-bit byte offsets into the
+     * plaintext, so plaintexts are limited to max_plaintext_size bytes.
+     *
+     * The plaintext is never copied: it is either moved into shared storage,
+     * borrowed from the caller or mapped from a file.
+     *
+     * Lines and columns are resolved through an index of line beginnings,
+     * built on first use (so the first query must not race other queries).
      */
     class lexical_unit {
-        std::string              m_plaintext;
-        std::vector<token>       m_tokens;
-        std::vector<std::size_t> m_token_positions;
+        std::shared_ptr<void const> m_storage; ///< Keeps the plaintext alive (null if borrowed).
+        std::string_view            m_plaintext;
+        std::vector<token_type>    m_token_types;
+        std::vector<token_payload> m_token_payloads;
+        std::vector<std::uint32_t> m_token_positions;
+        std::vector<string>        m_token_strings; ///< Owns the strings referenced by string and identifier payloads.
+
+        mutable std::vector<std::uint32_t> m_line_offsets; ///< Offset of the beginning of each line (empty until built).
+
+        /// Build the index of line beginnings, unless already built.
+        void index_lines() const;
+
+        /// Construct a lexical unit viewing plaintext (see load()).
+        inline lexical_unit(std::shared_ptr<void const> a_storage, std::string_view a_plaintext) noexcept;
 
     public:
+        /// Size of the largest plaintext whose positions fit in a token position.
+        static constexpr std::size_t max_plaintext_size = std::numeric_limits<std::uint32_t>::max();
+
         /**
          * Construct a lexical unit for use with a lexical analyzer.
          * @param a_plaintext The plaintext of the unit.
+         * @throws std::length_error If the plaintext exceeds
+         *                           max_plaintext_size.
          */
-        explicit inline lexical_unit(std::string a_plaintext) noexcept;
+        explicit lexical_unit(std::string a_plaintext);
+
+        /**
+         * Construct a lexical unit analyzing plaintext in place.
+         * @param a_plaintext The plaintext of the unit.
+         * @param a_storage An optional handle keeping the plaintext alive;
+         *                  otherwise the plaintext must outlive the unit.
+         * @return The lexical unit.
+         * @throws std::length_error If the plaintext exceeds
+         *                           max_plaintext_size.
+         */
+        [[nodiscard]]
+        static lexical_unit load(std::string_view a_plaintext, std::shared_ptr<void const> a_storage = nullptr);
+
+        /**
+         * Map a file into memory read-only and construct a lexical unit
+         * analyzing it in place. The mapping lives as long as the unit.
+         * @param a_path The path of the file.
+         * @return The lexical unit.
+         * @throws std::runtime_error If the file cannot be mapped.
+         * @throws std::length_error If the file exceeds max_plaintext_size.
+         */
+        [[nodiscard]]
+        static lexical_unit load_file(std::filesystem::path const & a_path);
+
+        /**
+         * Check that a plaintext fits in a lexical unit.
+         * @param a_size The size of the plaintext in bytes.
+         * @throws std::length_error If the size exceeds max_plaintext_size.
+         */
+        static void check_plaintext_size(std::size_t a_size);
 
         [[nodiscard]]
         inline std::string_view plaintext() const noexcept;
 
+        /**
+         * Materialize the tokens of the unit.
+         * @return A copy of every token, in order.
+         */
+        [[nodiscard]]
+        std::vector<token> tokens() const;
+
+        /**
+         * Materialize a single token of the unit.
+         * @param a_index The index of the token.
+         * @return The token.
+         */
+        [[nodiscard]]
+        inline token token_at(std::size_t a_index) const noexcept;
+
+        [[nodiscard]]
+        inline std::size_t token_count() const noexcept;
+
+        [[nodiscard]]
+        inline std::span<token_type const> token_types() const noexcept;
+
+        /**
+         * Retrieve the untagged token payloads, to be interpreted according
+         * to token_types().
+         */
+        [[nodiscard]]
+        inline std::span<token_payload const> token_payloads() const noexcept;
+
         [[nodiscard]]
-        inline std::span<token const> tokens() const noexcept;
+        inline std::span<std::uint32_t const> token_positions() const noexcept;
+
+        /**
+         * Reserve capacity for tokens.
+         * @param a_token_count The amount of tokens to reserve space for.
+         */
+        void reserve_tokens(std::size_t a_token_count);
 
         /**
          * Add a token to the result of lexical analysis.
@@ -40,25 +145,101 @@ namespace rebar {
          * @param a_token_position The position of the token to add.
          */
         inline void push_token(token a_token, std::size_t a_token_position) noexcept;
+
+        /**
+         * Add tokens to the result of lexical analysis in bulk.
+         * @param a_types The types of the tokens to add.
+         * @param a_payloads The payloads of the tokens to add.
+         * @param a_positions The positions of the tokens to add.
+         * @param a_strings The strings referenced by string and identifier
+         *                  payloads, of which the unit keeps a reference.
+         */
+        void append_tokens(
+            std::span<token_type const> a_types,
+            std::span<token_payload const> a_payloads,
+            std::span<std::uint32_t const> a_positions,
+            std::span<string const> a_strings
+        );
+
+        /**
+         * Replace the plaintext of the unit with an edited plaintext, and a
+         * range of tokens with the tokens analyzed from the edited region.
+         * @param a_edited A lexical unit containing the edited plaintext and
+         *                 the replacement tokens (positioned in the edited
+         *                 plaintext).
+         * @param a_first The index of the first token to replace.
+         * @param a_last The index following the last token to replace.
+         * @param a_position_shift The change in position of the tokens
+         *                         following the replaced tokens.
+         */
+        void splice(lexical_unit const & a_edited, std::size_t a_first, std::size_t a_last, std::int64_t a_position_shift);
+
+        /// Get the amount of lines in the plaintext.
+        [[nodiscard]]
+        std::size_t line_count() const;
+
+        /**
+         * Find the line and column of a position in the plaintext.
+         * @param a_position The position (up to and including the end of
+         *                   the plaintext).
+         * @return The location of the position.
+         * @throws std::out_of_range If the position exceeds the plaintext.
+         */
+        [[nodiscard]]
+        plaintext_location location_of(std::size_t a_position) const;
+
+        /**
+         * Find the line and column of a token in the plaintext.
+         * @param a_index The index of the token.
+         * @return The location of the token.
+         */
+        [[nodiscard]]
+        inline plaintext_location token_location(std::size_t a_index) const;
     };
 
     // ###################################### INLINE DEFINITIONS ######################################
 
-    lexical_unit::lexical_unit(std::string a_plaintext) noexcept :
-        m_plaintext(std::move(a_plaintext))
+    lexical_unit::lexical_unit(std::shared_ptr<void const> a_storage, std::string_view const a_plaintext) noexcept :
+        m_storage(std::move(a_storage)),
+        m_plaintext(a_plaintext)
     {}
 
     std::string_view lexical_unit::plaintext() const noexcept {
         return m_plaintext;
     }
 
-    inline std::span<token const> lexical_unit::tokens() const noexcept {
-        return m_tokens;
+    plaintext_location lexical_unit::token_location(std::size_t const a_index) const {
+        return location_of(m_token_positions[a_index]);
+    }
+
+    token lexical_unit::token_at(std::size_t const a_index) const noexcept {
+        return token(m_token_types[a_index], m_token_payloads[a_index]);
+    }
+
+    std::size_t lexical_unit::token_count() const noexcept {
+        return m_token_types.size();
+    }
+
+    std::span<token_type const> lexical_unit::token_types() const noexcept {
+        return m_token_types;
+    }
+
+    std::span<token_payload const> lexical_unit::token_payloads() const noexcept {
+        return m_token_payloads;
+    }
+
+    std::span<std::uint32_t const> lexical_unit::token_positions() const noexcept {
+        return m_token_positions;
     }
 
     void lexical_unit::push_token(token a_token, std::size_t const a_token_position) noexcept {
-        m_tokens.emplace_back(std::move(a_token));
-        m_token_positions.push_back(a_token_position);
+        m_token_types.push_back(a_token.type());
+        m_token_payloads.push_back(a_token.payload());
+        m_token_positions.push_back(static_cast<std::uint32_t>(a_token_position));
+
+        if (a_token.is_identifier() || a_token.is_string()) {
+            m_token_strings.emplace_back(a_token.get_string());
+        }
     }
 
 }
@@ -72,57 +72,76 @@ namespace rebar {
      */
     using symbol_map = std::unordered_map<std::string_view, std::pair<symbol, bool>>;
 
+    /**
+     * A symbol together with its plaintext representation, for describing
+     * symbol sets at compile time.
+     */
+    struct symbol_definition {
+        std::string_view text;
+        symbol           value;
+        bool             keyword; ///< Mirrors the boolean paired with the symbol in a symbol_map.
+    };
+
+    /// The default Rebar symbol set.
+    inline constexpr std::array<symbol_definition, 44> default_symbols{{
+        { "~",     symbol::tilda,                   false, },
+        { "!",     symbol::exclamation,             false, },
+        { "!=",    symbol::exclamation_equals,      false, },
+        { "@",     symbol::at,                      false, },
+        { "#",     symbol::pound,                   false, },
+        { "$",     symbol::dollar,                  false, },
+        { "%",     symbol::percent,                 false, },
+        { "^",     symbol::carrot,                  false, },
+        { "^=",    symbol::carrot_equals,           false, },
+        { "&",     symbol::ampersand,               false, },
+        { "&=",    symbol::ampersand_equals,        false, },
+        { "&&",    symbol::double_ampersand,        false, },
+        { "&&=",   symbol::double_ampersand_equals, false, },
+        { "*",     symbol::star,                    false, },
+        { "*=",    symbol::star_equals,             false, },
+        { "(",     symbol::parenthesis_left,        false, },
+        { ")",     symbol::parenthesis_right,       false, },
+        { "[",     symbol::bracket_left,            false, },
+        { "]",     symbol::bracket_right,           false, },
+        { "{",     symbol::brace_left,              false, },
+        { "}",     symbol::brace_right,             false, },
+        { "-",     symbol::minus,                   false, },
+        { "--",    symbol::double_minus,            false, },
+        { "-=",    symbol::minus_equals,            false, },
+        { "+",     symbol::plus,                    false, },
+        { "++",    symbol::double_plus,             false, },
+        { "+=",    symbol::plus_equals,             false, },
+        { "=",     symbol::equals,                  false, },
+        { "==",    symbol::double_equals,           false, },
+        { "/",     symbol::slash,                   false, },
+        { "/=",    symbol::slash_equals,            false, },
+        { ":",     symbol::colon,                   false, },
+        { ";",     symbol::semicolon,               false, },
+        { ",",     symbol::comma,                   false, },
+        { ".",     symbol::period,                  false, },
+        { "<",     symbol::carrot_left,             false, },
+        { ">",     symbol::carrot_right,            false, },
+        { "|",     symbol::pipe,                    false, },
+        { "|=",    symbol::pipe_equals,             false, },
+        { "||",    symbol::double_pipe,             false, },
+        { "||=",   symbol::double_pipe_equals,      false, },
+        { "?",     symbol::question,                false, },
+        { "true",  symbol::boolean_true,            true,  },
+        { "false", symbol::boolean_false,           true,  },
+    }};
+
     /**
      * Generate the default Rebar symbol map.
      * @return The default Rebar symbol map.
      */
     inline symbol_map default_symbol_map() {
-        return {
-            { "~",     { symbol::tilda,                   false, } },
-            { "!",     { symbol::exclamation,             false, } },
-            { "!=",    { symbol::exclamation_equals,      false, } },
-            { "@",     { symbol::at,                      false, } },
-            { "#",     { symbol::pound,                   false, } },
-            { "$",     { symbol::dollar,                  false, } },
-            { "%",     { symbol::percent,                 false, } },
-            { "^",     { symbol::carrot,                  false, } },
-            { "^=",    { symbol::carrot_equals,           false, } },
-            { "&",     { symbol::ampersand,               false, } },
-            { "&=",    { symbol::ampersand_equals,        false, } },
-            { "&&",    { symbol::double_ampersand,        false, } },
-            { "&&=",   { symbol::double_ampersand_equals, false, } },
-            { "*",     { symbol::star,                    false, } },
-            { "*=",    { symbol::star_equals,             false, } },
-            { "(",     { symbol::parenthesis_left,        false, } },
-            { ")",     { symbol::parenthesis_right,       false, } },
-            { "[",     { symbol::bracket_left,            false, } },
-            { "]",     { symbol::bracket_right,           false, } },
-            { "{",     { symbol::brace_left,              false, } },
-            { "}",     { symbol::brace_right,             false, } },
-            { "-",     { symbol::minus,                   false, } },
-            { "--",    { symbol::double_minus,            false, } },
-            { "-=",    { symbol::minus_equals,            false, } },
-            { "+",     { symbol::plus,                    false, } },
-            { "++",    { symbol::double_plus,             false, } },
-            { "+=",    { symbol::plus_equals,             false, } },
-            { "=",     { symbol::equals,                  false, } },
-            { "==",    { symbol::double_equals,           false, } },
-            { "/",     { symbol::slash,                   false, } },
-            { "/=",    { symbol::slash_equals,            false, } },
-            { ":",     { symbol::colon,                   false, } },
-            { ";",     { symbol::semicolon,               false, } },
-            { ",",     { symbol::comma,                   false, } },
-            { ".",     { symbol::period,                  false, } },
-            { "<",     { symbol::carrot_left,             false, } },
-            { ">",     { symbol::carrot_right,            false, } },
-            { "|",     { symbol::pipe,                    false, } },
-            { "|=",    { symbol::pipe_equals,             false, } },
-            { "||",    { symbol::double_pipe,             false, } },
-            { "||=",   { symbol::double_pipe_equals,      false, } },
-            { "?",     { symbol::question,                false, } },
-            { "true",  { symbol::boolean_true,            true,  } },
-            { "false", { symbol::boolean_false,           true,  } },
-        };
+        symbol_map map;
+
+        for (auto const & definition : default_symbols) {
+            map.emplace(definition.text, std::pair(definition.value, definition.keyword));
+        }
+
+        return map;
     }
 
     constexpr std::string_view symbol_as_string(symbol const a_symbol) noexcept {
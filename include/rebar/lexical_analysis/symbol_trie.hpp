@@ -0,0 +1,326 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef SYMBOL_TRIE_HPP
+#define SYMBOL_TRIE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string_view>
+
+#include <rebar/lexical_analysis/symbol.hpp>
+
+namespace rebar {
+
+    /// The result of a longest-match symbol search.
+    struct symbol_match {
+        symbol      value   = symbol::null;
+        bool        keyword = false;        ///< Mirrors the boolean paired with the symbol in its symbol_map.
+        std::size_t length  = 0;            ///< Length of the matched plaintext, or zero if nothing matched.
+    };
+
+    /// Index of a symbol trie node. Zero is the root, and doubles as "no node".
+    using symbol_trie_index = std::uint16_t;
+
+    struct symbol_trie_node {
+        std::uint16_t edges_begin = 0;
+        std::uint16_t edges_count = 0;
+        bool          terminal    = false;
+        bool          keyword     = false;
+        symbol        value       = symbol::null;
+    };
+
+    struct symbol_trie_edge {
+        unsigned char     character = 0;
+        symbol_trie_index target    = 0;
+    };
+
+    /**
+     * The flattened tables of a symbol trie, sized at compile time.
+     * @tparam v_nodes The amount of nodes in the trie.
+     */
+    template <std::size_t v_nodes>
+    struct symbol_trie_tables {
+        std::array<symbol_trie_node, v_nodes>     nodes{};
+        std::array<symbol_trie_edge, v_nodes - 1> edges{};
+        std::array<symbol_trie_index, 256>        root_edges{};
+        std::size_t                               max_length = 0; ///< Length of the longest symbol.
+    };
+
+    /**
+     * Build the tables of a symbol trie from a compile-time symbol set.
+     * @tparam v_symbols A constexpr range of symbol_definition.
+     * @return The trie tables.
+     */
+    template <auto const & v_symbols>
+    consteval auto make_symbol_trie_tables();
+
+    /**
+     * The tables of a symbol trie for a compile-time symbol set, generated
+     * during compilation.
+     * @tparam v_symbols A constexpr range of symbol_definition.
+     */
+    template <auto const & v_symbols>
+    inline constexpr auto static_symbol_trie_tables_v = make_symbol_trie_tables<v_symbols>();
+
+    /**
+     * A compact trie for longest-match symbol recognition in a single forward
+     * walk over the plaintext.
+     *
+     * Nodes are stored breadth-first, with the outgoing edges of each node
+     * stored contiguously. The root's edges are additionally indexed by a
+     * direct 256-entry table, since every match attempt begins there.
+     *
+     * A trie either owns tables built at runtime from a symbol_map, or
+     * refers to tables generated at compile time, in which case it costs
+     * nothing to construct. Copies share their tables.
+     */
+    class symbol_trie {
+        std::shared_ptr<void const>       m_storage;
+        std::span<symbol_trie_node const> m_nodes;
+        std::span<symbol_trie_edge const> m_edges;
+        symbol_trie_index const *         m_root_edges;
+        std::size_t                       m_max_length;
+
+    public:
+        /**
+         * Build a trie matching every symbol in a symbol map.
+         * @param a_symbol_map The symbols to match.
+         * @throws std::length_error If the symbols require more nodes than
+         *                           a symbol_trie_index can address.
+         */
+        explicit symbol_trie(symbol_map const & a_symbol_map);
+
+        /**
+         * Construct a trie referring to compile-time generated tables.
+         * @param a_tables The tables, usually static_symbol_trie_tables_v.
+         */
+        template <std::size_t v_nodes>
+        explicit symbol_trie(symbol_trie_tables<v_nodes> const & a_tables) noexcept;
+
+        /**
+         * Find the longest symbol that prefixes a string.
+         * @param a_text The text to match against, beginning at the
+         *               candidate symbol.
+         * @return The longest match, with a length of zero if no symbol
+         *         prefixes the text.
+         */
+        [[nodiscard]]
+        inline symbol_match longest_match(std::string_view a_text) const noexcept;
+
+        /**
+         * Test if any symbol begins with a character.
+         * @param a_char The character to test.
+         * @return Whether the root of the trie has an edge for the character.
+         */
+        [[nodiscard]]
+        inline bool starts_symbol(unsigned char a_char) const noexcept;
+
+        [[nodiscard]]
+        inline std::size_t node_count() const noexcept;
+
+        /// Get the length of the longest symbol matched by the trie.
+        [[nodiscard]]
+        inline std::size_t max_length() const noexcept;
+    };
+
+    /**
+     * Get a trie for the default Rebar symbol set. The trie's tables are
+     * generated at compile time.
+     */
+    [[nodiscard]]
+    inline symbol_trie default_symbol_trie() noexcept;
+
+    // ###################################### INLINE DEFINITIONS ######################################
+
+    template <auto const & v_symbols>
+    consteval auto make_symbol_trie_tables() {
+        struct build_node {
+            std::size_t   parent    = 0;
+            unsigned char character = 0;
+            bool          terminal  = false;
+            bool          keyword   = false;
+            symbol        value     = symbol::null;
+        };
+
+        // Upper bound on the node count: one node per character.
+        constexpr std::size_t capacity = [] {
+            std::size_t result = 1;
+
+            for (symbol_definition const & definition : v_symbols) {
+                result += definition.text.size();
+            }
+
+            return result;
+        }();
+
+        struct build_tree {
+            std::array<build_node, capacity> nodes{};
+            std::size_t                      size = 1;
+        };
+
+        // Insert every symbol into an intermediate tree of parent links.
+        constexpr build_tree tree = [] {
+            build_tree result;
+
+            for (symbol_definition const & definition : v_symbols) {
+                if (definition.text.empty()) {
+                    continue;
+                }
+
+                std::size_t current = 0;
+
+                for (unsigned char const c : definition.text) {
+                    std::size_t child = 0;
+
+                    for (std::size_t i = 1; i < result.size; ++i) {
+                        if (result.nodes[i].parent == current && result.nodes[i].character == c) {
+                            child = i;
+                            break;
+                        }
+                    }
+
+                    if (child == 0) {
+                        child = result.size++;
+                        result.nodes[child].parent = current;
+                        result.nodes[child].character = c;
+                    }
+
+                    current = child;
+                }
+
+                result.nodes[current].terminal = true;
+                result.nodes[current].keyword = definition.keyword;
+                result.nodes[current].value = definition.value;
+            }
+
+            return result;
+        }();
+
+        static_assert(tree.size <= std::numeric_limits<symbol_trie_index>::max(), "Symbol set exceeds the capacity of a symbol trie.");
+
+        // Flatten breadth-first, visiting children in character order so
+        // that each node's edges are contiguous. The edge into the node at
+        // breadth-first position n is always edge n - 1.
+        symbol_trie_tables<tree.size> tables;
+
+        std::array<std::size_t, tree.size> order{};
+        std::size_t ordered = 1;
+
+        for (std::size_t i = 0; i < tree.size; ++i) {
+            auto const edges_begin = ordered - 1;
+
+            for (std::size_t j = 1; j < tree.size; ++j) {
+                if (tree.nodes[j].parent != order[i]) {
+                    continue;
+                }
+
+                // Insertion sort by character among the node's children.
+                auto position = ordered;
+
+                while (position - 1 > edges_begin && tree.nodes[order[position - 1]].character > tree.nodes[j].character) {
+                    order[position] = order[position - 1];
+                    --position;
+                }
+
+                order[position] = j;
+                ++ordered;
+            }
+
+            build_node const & current = tree.nodes[order[i]];
+
+            tables.nodes[i] = {
+                static_cast<std::uint16_t>(edges_begin),
+                static_cast<std::uint16_t>(ordered - 1 - edges_begin),
+                current.terminal,
+                current.keyword,
+                current.value,
+            };
+
+            for (auto edge = edges_begin; edge < ordered - 1; ++edge) {
+                tables.edges[edge] = {
+                    tree.nodes[order[edge + 1]].character,
+                    static_cast<symbol_trie_index>(edge + 1),
+                };
+            }
+        }
+
+        for (std::size_t edge = 0; edge < tables.nodes[0].edges_count; ++edge) {
+            tables.root_edges[tables.edges[edge].character] = tables.edges[edge].target;
+        }
+
+        for (symbol_definition const & definition : v_symbols) {
+            tables.max_length = std::max(tables.max_length, definition.text.size());
+        }
+
+        return tables;
+    }
+
+    template <std::size_t v_nodes>
+    symbol_trie::symbol_trie(symbol_trie_tables<v_nodes> const & a_tables) noexcept :
+        m_nodes(a_tables.nodes),
+        m_edges(a_tables.edges),
+        m_root_edges(a_tables.root_edges.data()),
+        m_max_length(a_tables.max_length)
+    {}
+
+    symbol_match symbol_trie::longest_match(std::string_view const a_text) const noexcept {
+        symbol_match match;
+
+        if (a_text.empty()) {
+            return match;
+        }
+
+        symbol_trie_index current = m_root_edges[static_cast<unsigned char>(a_text.front())];
+
+        for (std::size_t length = 1; current != 0; ++length) {
+            symbol_trie_node const & current_node = m_nodes[current];
+
+            if (current_node.terminal) {
+                match = { current_node.value, current_node.keyword, length };
+            }
+
+            if (length == a_text.size()) {
+                break;
+            }
+
+            auto const character = static_cast<unsigned char>(a_text[length]);
+            std::size_t const edges_end = current_node.edges_begin + current_node.edges_count;
+
+            current = 0;
+
+            for (std::size_t i = current_node.edges_begin; i < edges_end; ++i) {
+                if (m_edges[i].character == character) {
+                    current = m_edges[i].target;
+                    break;
+                }
+            }
+        }
+
+        return match;
+    }
+
+    bool symbol_trie::starts_symbol(unsigned char const a_char) const noexcept {
+        return m_root_edges[a_char] != 0;
+    }
+
+    std::size_t symbol_trie::node_count() const noexcept {
+        return m_nodes.size();
+    }
+
+    std::size_t symbol_trie::max_length() const noexcept {
+        return m_max_length;
+    }
+
+    symbol_trie default_symbol_trie() noexcept {
+        return symbol_trie(static_symbol_trie_tables_v<default_symbols>);
+    }
+
+}
+
+#endif //SYMBOL_TRIE_HPP
@@ -5,7 +5,9 @@
 #ifndef TOKEN_HPP
 #define TOKEN_HPP
 
-#include <variant>
+#include <cstdint>
+#include <memory>
+#include <new>
 
 #include <rebar/environment/types.hpp>
 #include <rebar/lexical_analysis/symbol.hpp>
@@ -14,7 +16,7 @@
 namespace rebar {
 
     /// Type of token stored in a rebar::token class.
-    enum class token_type {
+    enum class token_type : std::uint8_t {
         null    = 0,
 
         identifier = 1, ///< Represents a stored rebar::string.
@@ -24,8 +26,17 @@ namespace rebar {
         symbol     = 5, ///< Represents a stored rebar::symbol.
     };
 
-    /// Internal token data type (variant).
-    using token_data = std::variant<integer, number, string, symbol>;
+    /**
+     * The untagged value of a token, for compact token storage where the
+     * type is stored separately. String payloads do not own a reference to
+     * their string.
+     */
+    union token_payload {
+        integer          integer_value;
+        number           number_value;
+        string_reference string_value;
+        symbol           symbol_value;
+    };
 
     /**
      * Test if a type is a token data type (storable in a token).
@@ -59,10 +70,21 @@ namespace rebar {
 
     /**
      * A class to represent a lexical token in analyzed code.
+     *
+     * The value is stored in an untagged union discriminated by the token
+     * type, keeping a token to a single payload word and a type tag.
+     * Identifier and string tokens hold a string; all other tokens hold the
+     * trivial value matching their type (null tokens hold a symbol).
      */
     class token {
+        union {
+            integer m_integer;
+            number  m_number;
+            string  m_string;
+            symbol  m_symbol;
+        };
+
         token_type m_type;
-        token_data m_data;
 
     public:
         /**
@@ -91,11 +113,21 @@ namespace rebar {
         template <std::floating_point t_number>
         explicit token(t_number a_number) noexcept requires(!is_token_data_type_v<t_number>);
 
-        token(token const &) noexcept = default;
-        token(token &&)      noexcept = default;
+        /**
+         * Construct a token from an untagged payload.
+         * @param a_type The type of the payload.
+         * @param a_payload The payload. A reference is created to string
+         *                  payloads.
+         */
+        inline token(token_type a_type, token_payload a_payload) noexcept;
+
+        inline token(token const & a_token) noexcept;
+        inline token(token && a_token)      noexcept;
 
-        token & operator = (token const &) noexcept = default;
-        token & operator = (token &&)      noexcept = default;
+        inline ~token() noexcept;
+
+        inline token & operator = (token const & a_token) noexcept;
+        inline token & operator = (token && a_token)      noexcept;
 
         [[nodiscard]]
         bool operator == (token const & a_token) const noexcept;
@@ -150,17 +182,55 @@ namespace rebar {
         [[nodiscard]]
         inline symbol get_symbol() const noexcept;
 
+        /**
+         * Get the untagged value of the token.
+         * @return The payload, which does not own a reference to string
+         *         values.
+         */
+        [[nodiscard]]
+        inline token_payload payload() const noexcept;
+
         [[nodiscard]]
         std::string to_string() const noexcept;
+
+    private:
+        [[nodiscard]]
+        inline bool holds_string() const noexcept;
+
+        /**
+         * Begin the lifetime of the union member matching the token type,
+         * copying the value of another token.
+         * @note The union must not hold a string when this is called.
+         */
+        inline void construct_from(token const & a_token) noexcept;
+
+        /**
+         * Begin the lifetime of the union member matching the token type,
+         * moving the value of another token.
+         * @note The union must not hold a string when this is called.
+         */
+        inline void construct_from(token && a_token) noexcept;
     };
 
+    static_assert(sizeof(token) == 16, "Tokens must remain a single payload word and a type tag.");
+
     // ###################################### INLINE DEFINITIONS ######################################
 
     template <token_data_type t_data>
     token::token(t_data const & a_data, token_type const a_type) noexcept requires(!std::is_same_v<t_data, uint64_t>) :
-        m_type(a_type),
-        m_data(a_data)
-    {}
+        m_symbol(symbol::null),
+        m_type(a_type)
+    {
+        if constexpr (std::is_same_v<t_data, integer>) {
+            m_integer = a_data;
+        } else if constexpr (std::is_same_v<t_data, number>) {
+            m_number = a_data;
+        } else if constexpr (std::is_same_v<t_data, string>) {
+            new (&m_string) string(a_data);
+        } else {
+            m_symbol = a_data;
+        }
+    }
 
     template <std::integral t_integer>
     token::token(t_integer const a_integer) noexcept requires (!is_token_data_type_v<t_integer>) :
@@ -172,6 +242,77 @@ namespace rebar {
         token(static_cast<number>(a_number))
     {}
 
+    token::token(token_type const a_type, token_payload const a_payload) noexcept :
+        m_symbol(symbol::null),
+        m_type(a_type)
+    {
+        switch (a_type) {
+            case token_type::integer:
+                m_integer = a_payload.integer_value;
+                break;
+            case token_type::number:
+                m_number = a_payload.number_value;
+                break;
+            case token_type::identifier:
+            case token_type::string:
+                new (&m_string) string(a_payload.string_value);
+                break;
+            default:
+                m_symbol = a_payload.symbol_value;
+                break;
+        }
+    }
+
+    token::token(token const & a_token) noexcept :
+        m_symbol(symbol::null),
+        m_type(a_token.m_type)
+    {
+        construct_from(a_token);
+    }
+
+    token::token(token && a_token) noexcept :
+        m_symbol(symbol::null),
+        m_type(a_token.m_type)
+    {
+        construct_from(std::move(a_token));
+    }
+
+    token::~token() noexcept {
+        if (holds_string()) {
+            std::destroy_at(&m_string);
+        }
+    }
+
+    token & token::operator = (token const & a_token) noexcept {
+        if (this == &a_token) {
+            return *this;
+        }
+
+        if (holds_string()) {
+            std::destroy_at(&m_string);
+        }
+
+        m_type = a_token.m_type;
+        construct_from(a_token);
+
+        return *this;
+    }
+
+    token & token::operator = (token && a_token) noexcept {
+        if (this == &a_token) {
+            return *this;
+        }
+
+        if (holds_string()) {
+            std::destroy_at(&m_string);
+        }
+
+        m_type = a_token.m_type;
+        construct_from(std::move(a_token));
+
+        return *this;
+    }
+
     bool token::operator==(symbol const a_symbol) const noexcept {
         return is_symbol() && get_symbol() == a_symbol;
     }
@@ -206,7 +347,15 @@ namespace rebar {
 
     template <token_data_type t_data>
     t_data const & token::get() const noexcept {
-        return std::get<t_data>(m_data);
+        if constexpr (std::is_same_v<t_data, integer>) {
+            return m_integer;
+        } else if constexpr (std::is_same_v<t_data, number>) {
+            return m_number;
+        } else if constexpr (std::is_same_v<t_data, string>) {
+            return m_string;
+        } else {
+            return m_symbol;
+        }
     }
 
     integer token::get_integer() const noexcept {
@@ -225,6 +374,59 @@ namespace rebar {
         return get<symbol>();
     }
 
+    token_payload token::payload() const noexcept {
+        token_payload payload{};
+
+        switch (m_type) {
+            case token_type::integer:
+                payload.integer_value = get_integer();
+                break;
+            case token_type::number:
+                payload.number_value = get_number();
+                break;
+            case token_type::identifier:
+            case token_type::string:
+                payload.string_value = get_string().reference();
+                break;
+            default:
+                payload.symbol_value = m_symbol;
+                break;
+        }
+
+        return payload;
+    }
+
+    bool token::holds_string() const noexcept {
+        return m_type == token_type::identifier || m_type == token_type::string;
+    }
+
+    void token::construct_from(token const & a_token) noexcept {
+        switch (m_type) {
+            case token_type::integer:
+                m_integer = a_token.m_integer;
+                break;
+            case token_type::number:
+                m_number = a_token.m_number;
+                break;
+            case token_type::identifier:
+            case token_type::string:
+                new (&m_string) string(a_token.m_string);
+                break;
+            default:
+                m_symbol = a_token.m_symbol;
+                break;
+        }
+    }
+
+    void token::construct_from(token && a_token) noexcept {
+        if (holds_string()) {
+            new (&m_string) string(std::move(a_token.m_string));
+            return;
+        }
+
+        construct_from(static_cast<token const &>(a_token));
+    }
+
 }
 
 #endif //TOKEN_HPP
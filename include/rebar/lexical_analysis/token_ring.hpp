@@ -0,0 +1,140 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef TOKEN_RING_HPP
+#define TOKEN_RING_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <rebar/lexical_analysis/token.hpp>
+
+namespace rebar {
+
+    /// A token and the position in the plaintext at which it begins.
+    struct positioned_token {
+        token       value;
+        std::size_t position;
+    };
+
+    /**
+     * A bounded first-in first-out buffer of tokens, passing tokens from a
+     * lexical analyzer to their consumer without growing with the input.
+     */
+    class token_ring {
+        std::vector<positioned_token> m_slots;
+        std::size_t                   m_capacity;
+        std::size_t                   m_head = 0;
+        std::size_t                   m_size = 0;
+
+    public:
+        /**
+         * Construct an empty ring buffer.
+         * @param a_capacity The maximum amount of buffered tokens.
+         * @throws std::invalid_argument If the capacity is zero.
+         */
+        explicit inline token_ring(std::size_t a_capacity);
+
+        [[nodiscard]]
+        inline std::size_t capacity() const noexcept;
+
+        [[nodiscard]]
+        inline std::size_t size() const noexcept;
+
+        [[nodiscard]]
+        inline bool empty() const noexcept;
+
+        [[nodiscard]]
+        inline bool full() const noexcept;
+
+        /**
+         * Append a token to the back of the buffer.
+         * @param a_token The token to append.
+         * @param a_position The position of the token.
+         * @note The buffer must not be full.
+         */
+        inline void push(token a_token, std::size_t a_position);
+
+        /**
+         * Retrieve the token at the front of the buffer.
+         * @note The buffer must not be empty.
+         */
+        [[nodiscard]]
+        inline positioned_token const & front() const noexcept;
+
+        /**
+         * Remove and return the token at the front of the buffer.
+         * @note The buffer must not be empty.
+         */
+        inline positioned_token pop() noexcept;
+
+        /// Remove every token from the buffer.
+        inline void clear() noexcept;
+    };
+
+    // ###################################### INLINE DEFINITIONS ######################################
+
+    token_ring::token_ring(std::size_t const a_capacity) :
+        m_capacity(a_capacity)
+    {
+        if (a_capacity == 0) {
+            throw std::invalid_argument("A token ring must have a capacity of at least one token.");
+        }
+
+        // Slots are constructed on the first pass around the ring, and
+        // reassigned afterwards.
+        m_slots.reserve(a_capacity);
+    }
+
+    std::size_t token_ring::capacity() const noexcept {
+        return m_capacity;
+    }
+
+    std::size_t token_ring::size() const noexcept {
+        return m_size;
+    }
+
+    bool token_ring::empty() const noexcept {
+        return m_size == 0;
+    }
+
+    bool token_ring::full() const noexcept {
+        return m_size == m_capacity;
+    }
+
+    void token_ring::push(token a_token, std::size_t const a_position) {
+        auto const tail = (m_head + m_size) % m_capacity;
+
+        if (tail == m_slots.size()) {
+            m_slots.push_back({ std::move(a_token), a_position });
+        } else {
+            m_slots[tail] = { std::move(a_token), a_position };
+        }
+
+        ++m_size;
+    }
+
+    positioned_token const & token_ring::front() const noexcept {
+        return m_slots[m_head];
+    }
+
+    positioned_token token_ring::pop() noexcept {
+        auto result = std::move(m_slots[m_head]);
+
+        m_head = (m_head + 1) % m_capacity;
+        --m_size;
+
+        return result;
+    }
+
+    void token_ring::clear() noexcept {
+        m_slots.clear();
+        m_head = 0;
+        m_size = 0;
+    }
+
+}
+
+#endif //TOKEN_RING_HPP
@@ -0,0 +1,100 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef TOKEN_STREAM_HPP
+#define TOKEN_STREAM_HPP
+
+#include <functional>
+#include <istream>
+#include <optional>
+#include <span>
+#include <string>
+
+#include <rebar/lexical_analysis/lexical_analyzer.hpp>
+#include <rebar/lexical_analysis/token_ring.hpp>
+
+namespace rebar {
+
+    /**
+     * A function reading the next part of a plaintext into a buffer.
+     * Returns the amount of characters read, or zero at the end of the
+     * plaintext.
+     */
+    using source_reader = std::function<std::size_t (std::span<char> a_buffer)>;
+
+    /**
+     * Create a source reader reading from an input stream.
+     * @param a_stream The stream to read from, which must outlive the reader.
+     */
+    [[nodiscard]]
+    source_reader make_stream_reader(std::istream & a_stream);
+
+    /**
+     * Create a source reader reading from a file descriptor.
+     * @param a_file_descriptor The file descriptor to read from. It is not
+     *                          closed by the reader.
+     * @throws std::system_error (When reading) if reading fails.
+     */
+    [[nodiscard]]
+    source_reader make_file_descriptor_reader(int a_file_descriptor);
+
+    /**
+     * Lexical analysis of a plaintext read in chunks, producing tokens on
+     * demand.
+     *
+     * Only the current chunk, the beginning of any token straddling its end,
+     * and a bounded ring of analyzed tokens are held, so memory use does not
+     * depend on the size of the plaintext. The tokens and positions produced
+     * are those of lexical_analyzer::perform_analysis() on the complete
+     * plaintext.
+     */
+    class token_stream {
+        lexical_analyzer const * m_analyzer;
+        source_reader            m_reader;
+        std::size_t              m_chunk_size;
+        std::string              m_buffer;          ///< Plaintext read from the source.
+        std::size_t              m_buffer_position; ///< Position of the buffer in the plaintext.
+        std::size_t              m_buffer_analyzed; ///< Length of the analyzed prefix of the buffer.
+        bool                     m_input_ended;
+        token_ring               m_tokens;
+
+    public:
+        static constexpr std::size_t default_chunk_size     = 64 * 1024;
+        static constexpr std::size_t default_token_capacity = 4096;
+
+        /**
+         * Construct a token stream.
+         * @param a_analyzer The analyzer with which to analyze the plaintext.
+         *                   It must outlive the stream.
+         * @param a_reader The source of the plaintext.
+         * @param a_chunk_size The amount of characters to read at once.
+         * @param a_token_capacity The maximum amount of tokens analyzed
+         *                         ahead of the consumer.
+         * @throws std::invalid_argument If the chunk size or token capacity
+         *                               is zero.
+         */
+        token_stream(
+            lexical_analyzer const & a_analyzer,
+            source_reader a_reader,
+            std::size_t a_chunk_size = default_chunk_size,
+            std::size_t a_token_capacity = default_token_capacity
+        );
+
+        /**
+         * Retrieve the next token of the plaintext, reading and analyzing
+         * more of the plaintext as needed.
+         * @return The next token, or std::nullopt at the end of the
+         *         plaintext.
+         */
+        [[nodiscard]]
+        std::optional<positioned_token> next();
+
+    private:
+        /// Analyze buffered plaintext, reading more as needed, until a token is available or the plaintext ends.
+        void refill();
+    };
+
+}
+
+#endif //TOKEN_STREAM_HPP
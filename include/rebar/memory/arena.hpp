@@ -0,0 +1,102 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace rebar {
+
+    /// Default size of each chunk of memory reserved by an arena.
+    constexpr std::size_t arena_chunk_size = 64 * 1024;
+
+    /**
+     * A monotonic bump allocator. Memory is handed out sequentially from
+     * large chunks and only released when the arena is destroyed; objects
+     * constructed in an arena are never destroyed.
+     *
+     * The arena is a polymorphic memory resource, so standard containers can
+     * place their storage in it.
+     */
+    class arena final : public std::pmr::memory_resource {
+        std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+
+        std::byte * m_cursor    = nullptr;
+        std::size_t m_remaining = 0;
+
+        std::size_t m_chunk_size;
+        std::size_t m_reserved_bytes = 0;
+        std::size_t m_used_bytes     = 0;
+
+    public:
+        /**
+         * @param a_chunk_size The size of each chunk of memory to reserve.
+         *                     Larger requests receive dedicated chunks.
+         */
+        explicit arena(std::size_t a_chunk_size = arena_chunk_size) noexcept;
+
+        arena(arena const &) = delete;
+        arena(arena &&)      = delete;
+
+        arena & operator = (arena const &) = delete;
+        arena & operator = (arena &&)      = delete;
+
+        /**
+         * Allocate and construct an object in the arena. The object is never
+         * destroyed.
+         * @tparam t_type The type of the object to construct.
+         * @param a_args The constructor arguments.
+         * @return A pointer to the constructed object.
+         */
+        template <typename t_type, typename ...t_args>
+        [[nodiscard]]
+        t_type * construct(t_args && ...a_args);
+
+        /**
+         * Retrieve the amount of bytes reserved by the arena.
+         * @return The reserved byte count.
+         */
+        [[nodiscard]]
+        inline std::size_t reserved_bytes() const noexcept;
+
+        /**
+         * Retrieve the amount of bytes handed out by the arena (including
+         * alignment padding).
+         * @return The used byte count.
+         */
+        [[nodiscard]]
+        inline std::size_t used_bytes() const noexcept;
+
+    private:
+        void * do_allocate(std::size_t a_size, std::size_t a_alignment) override;
+        void do_deallocate(void * a_pointer, std::size_t a_size, std::size_t a_alignment) override;
+
+        [[nodiscard]]
+        bool do_is_equal(std::pmr::memory_resource const & a_other) const noexcept override;
+    };
+
+    // ###################################### INLINE DEFINITIONS ######################################
+
+    template <typename t_type, typename ...t_args>
+    t_type * arena::construct(t_args && ...a_args) {
+        return new (allocate(sizeof(t_type), alignof(t_type))) t_type{ std::forward<t_args>(a_args)... };
+    }
+
+    std::size_t arena::reserved_bytes() const noexcept {
+        return m_reserved_bytes;
+    }
+
+    std::size_t arena::used_bytes() const noexcept {
+        return m_used_bytes;
+    }
+
+}
+
+#endif //ARENA_HPP
@@ -0,0 +1,273 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef POOL_ALLOCATOR_HPP
+#define POOL_ALLOCATOR_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace rebar {
+
+    /**
+     * Block sizes (in bytes) of the size classes served by the pool
+     * allocator. Requests larger than the largest class are forwarded to the
+     * global allocator.
+     *
+     * Every class is a multiple of 16 bytes, so every block is suitably
+     * aligned for any complex object payload.
+     */
+    constexpr std::array<std::size_t, 8> pool_size_classes{ 16, 32, 48, 64, 96, 128, 192, 256 };
+
+    /// Amount of size classes served by the pool allocator.
+    constexpr std::size_t pool_size_class_count = pool_size_classes.size();
+
+    /// Size of each chunk of memory that is carved into blocks of a class.
+    constexpr std::size_t pool_chunk_size = 16 * 1024;
+
+    /**
+     * Maximum amount of free blocks held by a thread-local free list before
+     * half of them are returned to the shared free list of the class.
+     */
+    constexpr std::size_t pool_thread_cache_limit = 64;
+
+    /**
+     * Amount of blocks moved at a time between a thread-local free list and
+     * the shared free list of a class.
+     */
+    constexpr std::size_t pool_transfer_batch = pool_thread_cache_limit / 2;
+
+    /**
+     * Occupancy statistics of a single size class.
+     */
+    struct pool_class_statistics {
+        std::size_t block_size;        ///< Size of every block in the class.
+        std::size_t chunk_count;       ///< Amount of chunks reserved for the class.
+        std::size_t reserved_blocks;   ///< Amount of blocks carved from the chunks.
+        std::size_t used_blocks;       ///< Amount of blocks currently handed out.
+        std::size_t shared_free_blocks; /**< Amount of blocks on the shared free
+                                         *   list (the remaining unused blocks
+                                         *   are held by thread-local lists).
+                                         */
+        std::size_t total_allocations; ///< Amount of allocations ever served.
+    };
+
+    /**
+     * Occupancy statistics of a pool allocator.
+     */
+    struct pool_statistics {
+        std::array<pool_class_statistics, pool_size_class_count> classes;
+
+        std::size_t oversized_used;        ///< Oversized allocations currently alive.
+        std::size_t oversized_allocations; ///< Oversized allocations ever served.
+
+        /**
+         * Total amount of bytes reserved for pooled blocks.
+         * @return The reserved byte count.
+         */
+        [[nodiscard]]
+        inline std::size_t reserved_bytes() const noexcept;
+
+        /**
+         * Total amount of bytes of pooled blocks currently handed out.
+         * @return The used byte count.
+         */
+        [[nodiscard]]
+        inline std::size_t used_bytes() const noexcept;
+    };
+
+    /**
+     * A size-class pool allocator for fixed-size complex object payloads
+     * (array headers, table headers, function and native wrappers, etc.).
+     *
+     * Each size class keeps a shared free list guarded by a mutex. Every
+     * thread additionally keeps its own free list per class and allocator,
+     * so the common allocate/deallocate path takes no locks; blocks move
+     * between the thread-local and the shared lists in batches.
+     */
+    class pool_allocator {
+        struct free_block {
+            free_block * next;
+        };
+
+        struct size_class {
+            std::mutex mutable                       mutex;
+            free_block *                             free_list       = nullptr;
+            std::size_t                              free_count      = 0;
+            std::size_t                              reserved_blocks = 0;
+            std::vector<std::unique_ptr<std::byte[]>> chunks;
+
+            std::atomic<std::size_t> allocations   = 0;
+            std::atomic<std::size_t> deallocations = 0;
+        };
+
+        struct thread_cache;
+        struct thread_cache_set;
+
+        std::uint64_t                                m_id;
+        std::array<size_class, pool_size_class_count> m_classes;
+
+        std::atomic<std::size_t> m_oversized_allocations   = 0;
+        std::atomic<std::size_t> m_oversized_deallocations = 0;
+
+    public:
+        pool_allocator();
+        ~pool_allocator();
+
+        pool_allocator(pool_allocator const &) = delete;
+        pool_allocator(pool_allocator &&)      = delete;
+
+        pool_allocator & operator = (pool_allocator const &) = delete;
+        pool_allocator & operator = (pool_allocator &&)      = delete;
+
+        /**
+         * Allocate a block of memory of at least the requested size.
+         * @param a_size The size of the block to allocate.
+         * @return A pointer to the allocated block.
+         */
+        [[nodiscard]]
+        void * allocate(std::size_t a_size);
+
+        /**
+         * Return a block of memory to the pool.
+         * @param a_pointer The block to return.
+         * @param a_size The size originally passed to allocate().
+         */
+        void deallocate(void * a_pointer, std::size_t a_size) noexcept;
+
+        /**
+         * Allocate and construct an object in the pool.
+         * @tparam t_type The type of the object to construct.
+         * @param a_args The constructor arguments.
+         * @return A pointer to the constructed object.
+         */
+        template <typename t_type, typename ...t_args>
+        [[nodiscard]]
+        t_type * construct(t_args && ...a_args);
+
+        /**
+         * Destroy and deallocate an object constructed with construct().
+         * @param a_pointer The object to destroy.
+         */
+        template <typename t_type>
+        void destroy(t_type * a_pointer) noexcept;
+
+        /**
+         * Collect the occupancy statistics of the allocator.
+         * @return The current statistics.
+         */
+        [[nodiscard]]
+        pool_statistics statistics() const noexcept;
+
+        /**
+         * Find the size class that serves a requested size.
+         * @param a_size The requested allocation size.
+         * @return The index of the size class, or pool_size_class_count if
+         *         the size is larger than every class.
+         */
+        [[nodiscard]]
+        static constexpr std::size_t size_class_index(std::size_t a_size) noexcept;
+
+    private:
+        [[nodiscard]]
+        static thread_cache_set & local_cache_set() noexcept;
+
+        [[nodiscard]]
+        thread_cache & local_cache() noexcept;
+
+        /**
+         * Move a batch of blocks from the shared free list (or a new chunk)
+         * to a thread-local free list.
+         */
+        void refill(thread_cache & a_cache, std::size_t a_class_index);
+
+        /**
+         * Return a list of blocks to the shared free list of a class.
+         */
+        void reclaim(std::size_t a_class_index, free_block * a_head, std::size_t a_count) noexcept;
+
+        /**
+         * Return the blocks held by a thread-local cache to their allocator,
+         * if it is still alive.
+         */
+        static void release_cache(thread_cache & a_cache) noexcept;
+    };
+
+    // ###################################### INLINE DEFINITIONS ######################################
+
+    std::size_t pool_statistics::reserved_bytes() const noexcept {
+        std::size_t total = 0;
+
+        for (auto const & class_statistics : classes) {
+            total += class_statistics.reserved_blocks * class_statistics.block_size;
+        }
+
+        return total;
+    }
+
+    std::size_t pool_statistics::used_bytes() const noexcept {
+        std::size_t total = 0;
+
+        for (auto const & class_statistics : classes) {
+            total += class_statistics.used_blocks * class_statistics.block_size;
+        }
+
+        return total;
+    }
+
+    template <typename t_type, typename ...t_args>
+    t_type * pool_allocator::construct(t_args && ...a_args) {
+        static_assert(alignof(t_type) <= 16, "Pooled types must not be over-aligned.");
+
+        void * const memory = allocate(sizeof(t_type));
+
+        try {
+            return new (memory) t_type{ std::forward<t_args>(a_args)... };
+        } catch (...) {
+            deallocate(memory, sizeof(t_type));
+            throw;
+        }
+    }
+
+    template <typename t_type>
+    void pool_allocator::destroy(t_type * const a_pointer) noexcept {
+        a_pointer->~t_type();
+        deallocate(a_pointer, sizeof(t_type));
+    }
+
+    constexpr std::size_t pool_allocator::size_class_index(std::size_t const a_size) noexcept {
+        // Lookup table of class indices by size in 16-byte granules.
+        constexpr auto granule_classes = [] {
+            std::array<std::size_t, pool_size_classes.back() / 16 + 1> table{};
+
+            std::size_t class_index = 0;
+
+            for (std::size_t granule = 0; granule < table.size(); ++granule) {
+                while (pool_size_classes[class_index] < granule * 16) {
+                    ++class_index;
+                }
+
+                table[granule] = class_index;
+            }
+
+            return table;
+        }();
+
+        if (a_size > pool_size_classes.back()) [[unlikely]] {
+            return pool_size_class_count;
+        }
+
+        return granule_classes[(a_size + 15) / 16];
+    }
+
+}
+
+#endif //POOL_ALLOCATOR_HPP
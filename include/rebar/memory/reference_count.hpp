@@ -0,0 +1,25 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef REFERENCE_COUNT_HPP
+#define REFERENCE_COUNT_HPP
+
+#include <cstddef>
+#include <limits>
+
+namespace rebar {
+
+    /**
+     * Reference count of immortal payloads (such as those of frozen objects).
+     * Immortal payloads are never referenced, dereferenced or destroyed, so
+     * they can be read from any thread without synchronization.
+     *
+     * Every payload header starts with its reference count, so immortality
+     * can be tested without knowing the type of the payload.
+     */
+    constexpr std::size_t immortal_reference_count = std::numeric_limits<std::size_t>::max();
+
+}
+
+#endif //REFERENCE_COUNT_HPP
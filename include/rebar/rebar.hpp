@@ -7,14 +7,23 @@
 
 #include <rebar/debug/flags.hpp>
 #include <rebar/debug/logging.hpp>
+#include <rebar/environment/array.hpp>
 #include <rebar/environment/environment.hpp>
+#include <rebar/environment/frozen.hpp>
+#include <rebar/environment/native.hpp>
 #include <rebar/environment/object.hpp>
+#include <rebar/environment/operations.hpp>
+#include <rebar/environment/serialization.hpp>
+#include <rebar/environment/table.hpp>
 #include <rebar/environment/types.hpp>
 #include <rebar/lexical_analysis/escape_sequence.hpp>
 #include <rebar/lexical_analysis/lexical_analyzer.hpp>
 #include <rebar/lexical_analysis/lexical_unit.hpp>
 #include <rebar/lexical_analysis/symbol.hpp>
 #include <rebar/lexical_analysis/token.hpp>
+#include <rebar/memory/arena.hpp>
+#include <rebar/memory/pool_allocator.hpp>
+#include <rebar/memory/reference_count.hpp>
 #include <rebar/semantic_analysis/operation_tree.hpp>
 #include <rebar/semantic_analysis/operators.hpp>
 #include <rebar/semantic_analysis/semantic_analyzer.hpp>
@@ -22,6 +31,7 @@
 #include <rebar/string/string.hpp>
 #include <rebar/string/string_engine.hpp>
 #include <rebar/util/equal_to.hpp>
+#include <rebar/util/hash.hpp>
 #include <rebar/util/print.hpp>
 #include <rebar/util/static_string.hpp>
 
@@ -5,6 +5,8 @@
 #ifndef OPERATORS_H
 #define OPERATORS_H
 
+#include <vector>
+
 #include <rebar/lexical_analysis/symbol.hpp>
 
 namespace rebar {
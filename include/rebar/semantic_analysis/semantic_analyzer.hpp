@@ -53,9 +53,20 @@ namespace rebar {
         void perform_analysis(semantic_unit & a_semantic_unit, lexical_unit const & a_lexical_unit) const;
 
     private:
-        operation_tree      parse_block_scope(semantic_unit & a_semantic_unit, std::span<token const> a_tokens) const;
+        operation_tree      parse_block_scope(semantic_unit & a_semantic_unit, lexical_unit const & a_lexical_unit) const;
         operation_tree_node parse_expression(semantic_unit & a_semantic_unit, std::span<token const> a_tokens) const;
 
+        /**
+         * Find the end of the statement beginning at a token, scanning only
+         * token types and payloads.
+         * @param a_lexical_unit The lexical unit containing the tokens.
+         * @param a_begin The index of the first token of the statement.
+         * @return The index of the semicolon ending the statement on the same
+         *         scope level, or the token count if there is none.
+         */
+        [[nodiscard]]
+        std::size_t find_statement_end(lexical_unit const & a_lexical_unit, std::size_t a_begin) const noexcept;
+
         /**
          * Find the first token matching the predicate function on the same
          * scope level.
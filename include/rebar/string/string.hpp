@@ -14,13 +14,17 @@ namespace rebar {
     class string_engine;
 
     class string {
-        string_engine *  m_engine;
         string_reference m_container;
 
     public:
         /// Null string constructor.
         inline string() noexcept;
 
+        /**
+         * Constructs a string from a container. Creates a new reference.
+         * @note The container carries its owning engine; the engine argument
+         *       is kept for source compatibility.
+         */
         inline string(string_engine& a_engine, string_reference a_container) noexcept;
 
         inline ~string() noexcept;
@@ -57,6 +61,11 @@ namespace rebar {
         [[nodiscard]]
         inline std::string_view view() const noexcept;
 
+        /**
+         * Retrieve the engine that owns the string.
+         * @return The owning engine.
+         * @note Immortal (frozen) strings are not owned by an engine.
+         */
         [[nodiscard]]
         inline string_engine & parent_engine() const noexcept;
 
@@ -64,7 +73,14 @@ namespace rebar {
         inline string_reference reference() const noexcept;
 
     private:
+        /**
+         * Constructs a string from a container, which may be immortal
+         * (frozen). Creates a new reference.
+         */
+        inline explicit string(string_reference a_container) noexcept;
+
         friend class object;
+        friend class token;
     };
 
     // IO stream interoperability.
@@ -75,32 +91,33 @@ namespace rebar {
     // ###################################### INLINE DEFINITIONS ######################################
 
     string::string() noexcept :
-        m_engine(nullptr),
         m_container(nullptr)
     {}
 
-    string::string(string_engine & a_engine, string_reference const a_container) noexcept : // NOLINT(*-misplaced-const)
-        m_engine(&a_engine),
+    string::string(string_engine &, string_reference const a_container) noexcept : // NOLINT(*-misplaced-const)
+        string(a_container)
+    {}
+
+    string::string(string_reference const a_container) noexcept : // NOLINT(*-misplaced-const)
         m_container(a_container)
     {
         m_container->reference();
     }
 
     string::~string() {
-        // Do nothing if string is null.
-        if (m_container == nullptr) {
+        // Do nothing if string is null or immortal.
+        if (m_container == nullptr || m_container->immortal()) {
             return;
         }
 
-        m_container->dereference(*m_engine);
+        m_container->dereference();
     }
 
     string::string(string const & m_string) noexcept :
-        string(*m_string.m_engine, m_string.m_container)
+        string(m_string.m_container)
     {}
 
     string::string(string && m_string) noexcept :
-        m_engine(m_string.m_engine),
         m_container(m_string.m_container)
     {
         m_string.m_container = nullptr;
@@ -111,7 +128,6 @@ namespace rebar {
             return *this;
         }
 
-        m_engine = a_string.m_engine;
         m_container = a_string.m_container;
 
         m_container->reference();
@@ -120,7 +136,6 @@ namespace rebar {
     }
 
     string & string::operator = (string && a_string) noexcept {
-        m_engine = a_string.m_engine;
         m_container = a_string.m_container;
 
         a_string.m_container = nullptr;
@@ -129,7 +144,11 @@ namespace rebar {
     }
 
     bool string::operator == (string const & a_string) const noexcept {
-        return m_container == a_string.m_container;
+        // Immortal strings are not interned by an engine, so compare their
+        // characters.
+        return
+            m_container == a_string.m_container ||
+            ((m_container->immortal() || a_string.m_container->immortal()) && m_container->string == a_string.m_container->string);
     }
 
     std::string_view string::view() const noexcept {
@@ -137,7 +156,7 @@ namespace rebar {
     }
 
     inline string_engine & string::parent_engine() const noexcept {
-        return *m_engine;
+        return *m_container->engine;
     }
 
     inline string_reference string::reference() const noexcept {
@@ -8,12 +8,15 @@
 #include <string>
 #include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <string_view>
 #include <unordered_map>
 
 #include <fmt/format.h>
 
 #include <rebar/debug/flags.hpp>
 #include <rebar/debug/logging.hpp>
+#include <rebar/memory/reference_count.hpp>
 
 namespace rebar {
      /*
@@ -26,11 +29,21 @@ namespace rebar {
 
     /**
      * A struct to store a reference count and stored string for the string
-     * engine.
+     * engine. The characters of the string are stored directly after the
+     * struct, in the same allocation.
      */
     struct internal_string {
-        std::size_t       reference_count;
-        std::string const string;
+        std::size_t            reference_count;
+        string_engine * const  engine; ///< Engine that owns the string (null if immortal).
+        std::size_t const      hash;   ///< Hash of the characters of the string.
+        std::string_view const string;
+
+        /**
+         * Test if the string is immortal (frozen), in which case it is not
+         * owned by any engine and is never collected.
+         */
+        [[nodiscard]]
+        inline bool immortal() const noexcept;
 
         /**
          * Increases the reference counter of the string.
@@ -38,15 +51,31 @@ namespace rebar {
         inline void reference();
 
         /**
-         * Decreases the reference counter and initiates garbage collection if
-         * needed.
-         * @param a_engine The engine that owns the string (to perform garbage collection).
+         * Decreases the reference counter and initiates garbage collection
+         * through the owning engine if needed.
          */
-        inline void dereference(string_engine & a_engine);
+        inline void dereference();
     };
 
     using string_reference = internal_string *;
 
+    /**
+     * Create an internal string with its characters in a single block of
+     * memory.
+     * @param a_resource The memory resource from which to allocate the block.
+     * @param a_engine The engine that owns the string (null if immortal).
+     * @param a_string The characters of the string.
+     * @param a_reference_count The initial reference count.
+     * @return The created internal string.
+     */
+    [[nodiscard]]
+    internal_string * make_internal_string(std::pmr::memory_resource & a_resource, string_engine * a_engine, std::string_view a_string, std::size_t a_reference_count);
+
+    /// Destroys internal strings created from the default memory resource.
+    struct internal_string_deleter {
+        void operator () (internal_string * a_string) const noexcept;
+    };
+
     /**
      *  A class to enforce universal-reference strings (that is, each unique
      *  string will only have one copy) and enable quick string operations with
@@ -64,16 +93,18 @@ namespace rebar {
          *
          * Strings are expected to be in UTF-8 encoding.
          */
-        std::unordered_map<std::string_view, std::unique_ptr<internal_string>> m_strings;
+        std::unordered_map<std::string_view, std::unique_ptr<internal_string, internal_string_deleter>> m_strings;
 
     public:
         string_engine() noexcept = default;
 
-        string_engine(string_engine const &) noexcept = default;
-        string_engine(string_engine &&)      noexcept = default;
+        // Engines cannot move, as every stored string refers back to the
+        // engine that releases it.
+        string_engine(string_engine const &) = delete;
+        string_engine(string_engine &&)      = delete;
 
-        string_engine & operator = (string_engine const &) noexcept = default;
-        string_engine & operator = (string_engine &&)      noexcept = default;
+        string_engine & operator = (string_engine const &) = delete;
+        string_engine & operator = (string_engine &&)      = delete;
 
         /**
          * Returns a Rebar string object of the supplied string.
@@ -108,7 +139,15 @@ namespace rebar {
 
     // ###################################### INLINE DEFINITIONS ######################################
 
+    inline bool internal_string::immortal() const noexcept {
+        return reference_count == immortal_reference_count;
+    }
+
     inline void internal_string::reference() {
+        if (immortal()) {
+            return;
+        }
+
         ++reference_count;
 
         // Debug string reference message.
@@ -117,13 +156,17 @@ namespace rebar {
         }
     }
 
-    inline void internal_string::dereference(string_engine & a_engine) {
+    inline void internal_string::dereference() {
+        if (immortal()) {
+            return;
+        }
+
         if (--reference_count == 0) {
             if constexpr (debug_string_reference_messages) {
                 debug_log(fmt::format("String dereferenced and erased. (Total references: {}) (\"{}\")", reference_count, string));
             }
 
-            a_engine.erase_string(string);
+            engine->erase_string(string);
         } else if constexpr (debug_string_reference_messages) {
             debug_log(fmt::format("String dereferenced. (Total references: {}) (\"{}\")", reference_count, string));
         }
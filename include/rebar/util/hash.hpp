@@ -0,0 +1,44 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rebar {
+
+    /**
+     * Mix the bits of a value into a well-distributed hash (the SplitMix64
+     * finalizer).
+     * @param a_value The value to mix.
+     * @return The mixed hash.
+     */
+    [[nodiscard]]
+    constexpr std::size_t hash_mix(std::uint64_t a_value) noexcept {
+        a_value ^= a_value >> 30;
+        a_value *= 0xBF58476D1CE4E5B9ull;
+        a_value ^= a_value >> 27;
+        a_value *= 0x94D049BB133111EBull;
+        a_value ^= a_value >> 31;
+
+        return static_cast<std::size_t>(a_value);
+    }
+
+    /**
+     * Combine a hash into an accumulated seed. The result depends on the
+     * order in which hashes are combined.
+     * @param a_seed The accumulated hash.
+     * @param a_hash The hash to combine.
+     * @return The combined hash.
+     */
+    [[nodiscard]]
+    constexpr std::size_t hash_combine(std::size_t const a_seed, std::size_t const a_hash) noexcept {
+        return hash_mix(a_seed ^ (a_hash + 0x9E3779B97F4A7C15ull + (a_seed << 6) + (a_seed >> 2)));
+    }
+
+}
+
+#endif //HASH_HPP
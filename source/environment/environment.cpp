@@ -0,0 +1,80 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <rebar/environment/environment.hpp>
+#include <rebar/environment/array.hpp>
+#include <rebar/environment/table.hpp>
+
+namespace rebar {
+
+    object environment::array(std::size_t const a_reserve) {
+        auto * const array = m_pool_allocator->construct<internal_array>(1ull, m_pool_allocator.get());
+        array->elements.reserve(a_reserve);
+
+        return { type::array, std::bit_cast<object_data>(array) };
+    }
+
+    object environment::array_view(std::span<integer const> const a_elements, std::shared_ptr<void const> a_owner) {
+        return typed_array(array_storage::integers, a_elements.data(), a_elements.size(), array_access::read_only, std::move(a_owner));
+    }
+
+    object environment::array_view(std::span<number const> const a_elements, std::shared_ptr<void const> a_owner) {
+        return typed_array(array_storage::numbers, a_elements.data(), a_elements.size(), array_access::read_only, std::move(a_owner));
+    }
+
+    object environment::array_view(std::span<integer> const a_elements, array_access const a_access, std::shared_ptr<void const> a_owner) {
+        return typed_array(array_storage::integers, a_elements.data(), a_elements.size(), a_access, std::move(a_owner));
+    }
+
+    object environment::array_view(std::span<number> const a_elements, array_access const a_access, std::shared_ptr<void const> a_owner) {
+        return typed_array(array_storage::numbers, a_elements.data(), a_elements.size(), a_access, std::move(a_owner));
+    }
+
+    object environment::table(table_mode const a_mode) {
+        auto * const table = m_pool_allocator->construct<internal_table>(1ull, m_pool_allocator.get(), compact_table(a_mode));
+        return { type::table, std::bit_cast<object_data>(table) };
+    }
+
+    object environment::global(std::string_view const a_name) const {
+        if (auto const it = m_globals.find(a_name); it != m_globals.cend()) {
+            return it->second.second;
+        }
+
+        return {};
+    }
+
+    void environment::set_global(std::string_view const a_name, object a_value) {
+        // Overwrite value if global already exists.
+        if (auto const it = m_globals.find(a_name); it != m_globals.cend()) {
+            it->second.second = std::move(a_value);
+            return;
+        }
+
+        // Key the global by a view of its interned name, which lives as long
+        // as the entry holds a reference to it.
+        auto name = str(a_name);
+        auto const name_view = name.view();
+
+        m_globals.emplace(name_view, std::pair{ std::move(name), std::move(a_value) });
+    }
+
+    object environment::typed_array(
+        array_storage const a_storage,
+        void const * const a_view,
+        std::size_t const a_length,
+        array_access const a_access,
+        std::shared_ptr<void const> a_owner
+    ) {
+        auto * const array = m_pool_allocator->construct<internal_array>(1ull, m_pool_allocator.get());
+
+        array->storage = a_storage;
+        array->view = a_view;
+        array->view_length = a_length;
+        array->access = a_access;
+        array->view_owner = std::move(a_owner);
+
+        return { type::array, std::bit_cast<object_data>(array) };
+    }
+
+}
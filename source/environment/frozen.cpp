@@ -0,0 +1,111 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <stdexcept>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+#include <rebar/environment/frozen.hpp>
+#include <rebar/environment/array.hpp>
+#include <rebar/environment/table.hpp>
+
+namespace rebar {
+
+    struct frozen_graph::freeze_state {
+        arena & target;
+
+        /// Frozen copies of the payloads frozen so far, by source payload.
+        std::unordered_map<object_data, object> copies = {};
+
+        /// Frozen strings, by their characters.
+        std::unordered_map<std::string_view, internal_string *> strings = {};
+    };
+
+    frozen_graph frozen_graph::freeze(object const & a_object) {
+        auto target = std::make_unique<arena>();
+
+        freeze_state state{ *target };
+        auto root = freeze_object(state, a_object);
+
+        return { nullptr, std::move(target), std::move(root) };
+    }
+
+    object frozen_graph::freeze_object(freeze_state & a_state, object const & a_object) {
+        if (a_object.type_integer() < complex_type_threshold) {
+            return a_object;
+        }
+
+        if (auto const it = a_state.copies.find(a_object.m_data); it != a_state.copies.cend()) {
+            return it->second;
+        }
+
+        switch (a_object.m_type) {
+            case type::string: {
+                auto const characters = a_object.string_view();
+
+                if (auto const it = a_state.strings.find(characters); it != a_state.strings.cend()) {
+                    return { type::string, std::bit_cast<object_data>(it->second) };
+                }
+
+                auto * const frozen_string = make_internal_string(a_state.target, nullptr, characters, immortal_reference_count);
+                a_state.strings.emplace(frozen_string->string, frozen_string);
+
+                return { type::string, std::bit_cast<object_data>(frozen_string) };
+            }
+            case type::array: {
+                auto const & source = *a_object.as_internal_array();
+
+                auto * const array = a_state.target.construct<internal_array>(
+                    immortal_reference_count,
+                    nullptr,
+                    std::pmr::vector<object>(&a_state.target)
+                );
+
+                object frozen{ type::array, std::bit_cast<object_data>(array) };
+                a_state.copies.emplace(a_object.m_data, frozen);
+
+                array->elements.reserve(source.length());
+
+                for (std::size_t i = 0; i < source.length(); ++i) {
+                    array->elements.push_back(freeze_object(a_state, source.at(i)));
+                }
+
+                // The elements are immutable, so the hash can always be
+                // memoized.
+                array->hash = frozen.hash();
+                array->hash_cached = true;
+
+                return frozen;
+            }
+            case type::table: {
+                auto const & source = *a_object.as_internal_table();
+
+                auto * const table = a_state.target.construct<internal_table>(
+                    immortal_reference_count,
+                    nullptr,
+                    compact_table(source.entries.size(), &a_state.target)
+                );
+
+                object frozen{ type::table, std::bit_cast<object_data>(table) };
+                a_state.copies.emplace(a_object.m_data, frozen);
+
+                for (auto const & entry : source.entries) {
+                    table->entries.insert_or_assign(freeze_object(a_state, entry.key), freeze_object(a_state, entry.value));
+                }
+
+                table->hash = frozen.hash();
+                table->hash_cached = true;
+
+                return frozen;
+            }
+            default:
+                throw std::invalid_argument(fmt::format(
+                    "Objects of type {} cannot be frozen.",
+                    type_as_string(a_object.m_type)
+                ));
+        }
+    }
+
+}
@@ -2,30 +2,81 @@
 // Created by maxng on 28/07/2024.
 //
 
+#include <cmath>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
 #include <rebar/environment/object.hpp>
+#include <rebar/environment/array.hpp>
 #include <rebar/environment/environment.hpp>
+#include <rebar/environment/native.hpp>
+#include <rebar/environment/numeric.hpp>
+#include <rebar/environment/table.hpp>
+#include <rebar/util/hash.hpp>
 
 namespace rebar {
 
+    namespace {
+
+        /**
+         * Test if the hash of a container holding an object may be memoized.
+         * Arrays and tables are copied on write, so an element can only be
+         * mutated through its container; natives, however, can be mutated in
+         * place, as can any container holding them.
+         * @note The hash of the object must have been computed.
+         */
+        bool memoizable_element(object const & a_object) noexcept {
+            switch (a_object.object_type()) {
+                case type::native:
+                    return false;
+                case type::array:
+                case type::table:
+                    return a_object.hash_memoized();
+                default:
+                    return true;
+            }
+        }
+
+        [[noreturn]]
+        void throw_frozen_mutation() {
+            throw std::logic_error("Frozen objects cannot be mutated.");
+        }
+
+    }
+
     void reference_object(object const * a_object) noexcept {
         // If type does not require referencing, return.
         if (auto const type_integer = a_object->type_integer(); type_integer < complex_type_threshold) {
             return;
         }
 
+        // Immortal (frozen) payloads are never written to.
+        if (a_object->is_frozen()) {
+            return;
+        }
+
         switch (a_object->m_type) {
             case type::string: {
                 a_object->as_internal_string()->reference();
                 break;
             }
-            case type::function:
+            case type::function: {
+                ++a_object->as_internal_function()->reference_count;
                 break;
-            case type::table:
+            }
+            case type::table: {
+                ++a_object->as_internal_table()->reference_count;
                 break;
-            case type::array:
+            }
+            case type::array: {
+                ++a_object->as_internal_array()->reference_count;
                 break;
-            case type::native:
+            }
+            case type::native: {
+                ++a_object->as_internal_native()->reference_count;
                 break;
+            }
             default:
                 break;
         }
@@ -37,22 +88,414 @@ namespace rebar {
             return;
         }
 
+        // Immortal (frozen) payloads are never written to.
+        if (a_object->is_frozen()) {
+            return;
+        }
+
         switch (a_object->m_type) {
             case type::string: {
-                a_object->as_internal_string()->dereference(*static_cast<string_engine *>(a_object->m_env));
+                a_object->as_internal_string()->dereference();
                 break;
             }
-            case type::function:
+            case type::function: {
+                if (auto * const function = a_object->as_internal_function(); --function->reference_count == 0) {
+                    release_weak_references(function);
+                    function->env->allocator().destroy(function);
+                }
+
                 break;
-            case type::table:
+            }
+            case type::table: {
+                if (auto * const table = a_object->as_internal_table(); --table->reference_count == 0) {
+                    release_weak_references(table);
+                    table->allocator->destroy(table);
+                }
+
                 break;
-            case type::array:
+            }
+            case type::array: {
+                if (auto * const array = a_object->as_internal_array(); --array->reference_count == 0) {
+                    release_weak_references(array);
+                    array->allocator->destroy(array);
+                }
+
                 break;
-            case type::native:
+            }
+            case type::native: {
+                if (auto * const native = a_object->as_internal_native(); --native->reference_count == 0) {
+                    release_weak_references(native);
+                    native->type_info->destroy(native, *native->allocator);
+                }
+
                 break;
+            }
             default:
                 break;
         }
     }
 
+    object object::call(std::span<object const> const a_arguments) const {
+        auto const & function = *as_internal_function();
+        return function.thunk(*function.env, function, a_arguments);
+    }
+
+    std::size_t object::array_length() const noexcept {
+        return as_internal_array()->length();
+    }
+
+    object object::array_at(std::size_t const a_index) const {
+        auto const * const array = as_internal_array();
+
+        if (a_index >= array->length()) [[unlikely]] {
+            throw std::out_of_range("Array index out of range.");
+        }
+
+        return array->at(a_index);
+    }
+
+    void object::array_set(std::size_t const a_index, object a_value) {
+        if (is_frozen()) [[unlikely]] {
+            throw_frozen_mutation();
+        }
+
+        // Read-write typed arrays write through to the memory they view,
+        // which every object sharing the payload observes.
+        if (auto * const array = as_internal_array(); array->access == array_access::read_write) {
+            if (a_index >= array->view_length) [[unlikely]] {
+                throw std::out_of_range("Array index out of range.");
+            }
+
+            if (array->storage == array_storage::integers) {
+                if (a_value.is_integer()) {
+                    const_cast<integer *>(static_cast<integer const *>(array->view))[a_index] = a_value.get_integer();
+                    return;
+                }
+
+                if (a_value.is_number() && integral_number(a_value.get_number())) {
+                    const_cast<integer *>(static_cast<integer const *>(array->view))[a_index] = static_cast<integer>(a_value.get_number());
+                    return;
+                }
+            } else if (a_value.is_integer() || a_value.is_number()) {
+                const_cast<number *>(static_cast<number const *>(array->view))[a_index] =
+                    a_value.is_integer() ? static_cast<number>(a_value.get_integer()) : a_value.get_number();
+
+                return;
+            }
+
+            throw std::invalid_argument(fmt::format(
+                "Cannot store a value of type {} in an array of {}.",
+                type_as_string(a_value.m_type),
+                array->storage == array_storage::integers ? "integers" : "numbers"
+            ));
+        }
+
+        auto * const array = unique_array();
+
+        array->elements.at(a_index) = std::move(a_value);
+        array->hash_cached = false;
+    }
+
+    void object::array_push(object a_value) {
+        if (is_frozen()) [[unlikely]] {
+            throw_frozen_mutation();
+        }
+
+        if (as_internal_array()->access == array_access::read_write) [[unlikely]] {
+            throw std::logic_error("Cannot change the length of a read-write typed array.");
+        }
+
+        auto * const array = unique_array();
+
+        array->elements.push_back(std::move(a_value));
+        array->hash_cached = false;
+    }
+
+    std::size_t object::table_size() const noexcept {
+        return as_internal_table()->entries.size();
+    }
+
+    compact_table const & object::table_entries() const noexcept {
+        return as_internal_table()->entries;
+    }
+
+    object object::table_get(object const & a_key) const {
+        if (auto const * const value = as_internal_table()->entries.find(a_key); value != nullptr) {
+            return *value;
+        }
+
+        return {};
+    }
+
+    void object::table_set(object a_key, object a_value) {
+        if (a_key.is_null() || (a_key.is_number() && std::isnan(a_key.get_number()))) [[unlikely]] {
+            throw std::invalid_argument("Table keys must not be null or NaN.");
+        }
+
+        if (is_frozen()) [[unlikely]] {
+            throw_frozen_mutation();
+        }
+
+        auto * const table = unique_table();
+        table->hash_cached = false;
+
+        if (a_value.is_null()) {
+            table->entries.erase(a_key);
+            return;
+        }
+
+        table->entries.insert_or_assign(std::move(a_key), std::move(a_value));
+    }
+
+    bool object::hash_memoized() const noexcept {
+        switch (m_type) {
+            case type::array:
+                return as_internal_array()->hash_cached;
+            case type::table:
+                return as_internal_table()->hash_cached;
+            default:
+                return false;
+        }
+    }
+
+    internal_array * object::unique_array() {
+        auto * array = as_internal_array();
+
+        // Typed arrays view memory they do not own, so convert them to
+        // object storage.
+        if (array->storage != array_storage::objects) [[unlikely]] {
+            std::pmr::vector<object> elements;
+            elements.reserve(array->view_length);
+
+            for (std::size_t i = 0; i < array->view_length; ++i) {
+                elements.push_back(array->at(i));
+            }
+
+            if (array->reference_count != 1) {
+                --array->reference_count;
+
+                array = array->allocator->construct<internal_array>(1ull, array->allocator);
+                m_data = std::bit_cast<object_data>(array);
+            }
+
+            array->elements = std::move(elements);
+            array->storage = array_storage::objects;
+            array->view = nullptr;
+            array->view_length = 0;
+            array->view_owner.reset();
+
+            return array;
+        }
+
+        if (array->reference_count == 1) [[likely]] {
+            return array;
+        }
+
+        // Copy the shared payload; the copy references every element.
+        auto * const copy = array->allocator->construct<internal_array>(
+            1ull,
+            array->allocator,
+            std::pmr::vector<object>(array->elements),
+            array->hash,
+            array->hash_cached
+        );
+
+        --array->reference_count;
+        m_data = std::bit_cast<object_data>(copy);
+
+        return copy;
+    }
+
+    internal_table * object::unique_table() {
+        auto * const table = as_internal_table();
+
+        if (table->reference_count == 1) [[likely]] {
+            return table;
+        }
+
+        auto * const copy = table->allocator->construct<internal_table>(
+            1ull,
+            table->allocator,
+            compact_table(table->entries),
+            table->hash,
+            table->hash_cached
+        );
+
+        --table->reference_count;
+        m_data = std::bit_cast<object_data>(copy);
+
+        return copy;
+    }
+
+    std::size_t object::hash() const {
+        auto const seed = hash_mix(type_integer());
+
+        switch (m_type) {
+            case type::number: {
+                // Integral numbers equal integers, so they must hash alike.
+                if (auto const value = get_number(); integral_number(value)) {
+                    return hash_combine(hash_mix(static_cast<std::uint64_t>(type::integer)), hash_mix(static_cast<integer>(value)));
+                }
+
+                return hash_combine(seed, hash_mix(m_data));
+            }
+            case type::integer:
+            case type::boolean:
+            case type::function:
+                return hash_combine(seed, hash_mix(m_data));
+            case type::string: {
+                // Hash the characters, as frozen strings are not interned.
+                return hash_combine(seed, as_internal_string()->hash);
+            }
+            case type::array: {
+                auto * const array = as_internal_array();
+
+                if (array->hash_cached) {
+                    return array->hash;
+                }
+
+                auto const length = array->length();
+                auto result = hash_combine(seed, length);
+                bool memoizable = true;
+
+                for (std::size_t i = 0; i < length; ++i) {
+                    auto const element = array->at(i);
+
+                    result = hash_combine(result, element.hash());
+                    memoizable = memoizable && memoizable_element(element);
+                }
+
+                // Frozen payloads are never written to after freezing, and
+                // the memory viewed by typed arrays may change at any time.
+                if (!is_frozen()) {
+                    array->hash = result;
+                    array->hash_cached = memoizable && array->storage == array_storage::objects;
+                }
+
+                return result;
+            }
+            case type::table: {
+                auto * const table = as_internal_table();
+
+                if (table->hash_cached) {
+                    return table->hash;
+                }
+
+                // Entries are unordered, so combine them commutatively.
+                std::size_t entries_hash = 0;
+                bool memoizable = true;
+
+                for (auto const & entry : table->entries) {
+                    entries_hash += hash_combine(entry.key.hash(), entry.value.hash());
+                    memoizable = memoizable && memoizable_element(entry.key) && memoizable_element(entry.value);
+                }
+
+                auto const result = hash_combine(hash_combine(seed, table->entries.size()), entries_hash);
+
+                // Entries of weak tables disappear on their own, so their
+                // hashes are never memoized.
+                if (!is_frozen()) {
+                    table->hash = result;
+                    table->hash_cached = memoizable && table->entries.mode() == table_mode::strong;
+                }
+
+                return result;
+            }
+            case type::native: {
+                auto const * const native = as_internal_native();
+                return hash_combine(hash_combine(seed, std::bit_cast<std::size_t>(native->type_info)), native->type_info->hash(native));
+            }
+            default:
+                return seed;
+        }
+    }
+
+    bool object::equals(object const & a_object) const {
+        if (m_type != a_object.m_type) {
+            if (is_integer() && a_object.is_number()) {
+                return integer_equals_number(get_integer(), a_object.get_number());
+            }
+
+            if (is_number() && a_object.is_integer()) {
+                return integer_equals_number(a_object.get_integer(), get_number());
+            }
+
+            return false;
+        }
+
+        if (m_type == type::number) {
+            return get_number() == a_object.get_number();
+        }
+
+        // Identical objects are equal; all remaining simply comparable types
+        // are compared by identity.
+        if (m_data == a_object.m_data) {
+            return true;
+        }
+
+        // Frozen strings are not interned, so compare their characters.
+        if (m_type == type::string) {
+            return (is_frozen() || a_object.is_frozen()) && string_view() == a_object.string_view();
+        }
+
+        if (type_integer() < complexly_comparable_threshold) {
+            return false;
+        }
+
+        switch (m_type) {
+            case type::array: {
+                auto const & lhs = *as_internal_array();
+                auto const & rhs = *a_object.as_internal_array();
+
+                auto const length = lhs.length();
+
+                if (length != rhs.length()) {
+                    return false;
+                }
+
+                if (lhs.hash_cached && rhs.hash_cached && lhs.hash != rhs.hash) {
+                    return false;
+                }
+
+                for (std::size_t i = 0; i < length; ++i) {
+                    if (!lhs.at(i).equals(rhs.at(i))) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+            case type::table: {
+                auto const & lhs = *as_internal_table();
+                auto const & rhs = *a_object.as_internal_table();
+
+                if (lhs.entries.size() != rhs.entries.size()) {
+                    return false;
+                }
+
+                if (lhs.hash_cached && rhs.hash_cached && lhs.hash != rhs.hash) {
+                    return false;
+                }
+
+                for (auto const & entry : lhs.entries) {
+                    auto const * const value = rhs.entries.find(entry.key);
+
+                    if (value == nullptr || !entry.value.equals(*value)) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+            case type::native: {
+                auto const * const lhs = as_internal_native();
+                auto const * const rhs = a_object.as_internal_native();
+
+                return lhs->type_info == rhs->type_info && lhs->type_info->equal(lhs, rhs);
+            }
+            default:
+                return false;
+        }
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,338 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <cmath>
+#include <compare>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <rebar/environment/operations.hpp>
+#include <rebar/environment/numeric.hpp>
+
+namespace rebar {
+
+    namespace {
+
+        constexpr bool is_numeric_type(type const a_type) noexcept {
+            return a_type == type::integer || a_type == type::number;
+        }
+
+        constexpr bool is_arithmetic_operation(operation const a_operation) noexcept {
+            return
+                a_operation == operation::addition       ||
+                a_operation == operation::subtraction    ||
+                a_operation == operation::multiplication ||
+                a_operation == operation::division       ||
+                a_operation == operation::exponentiation ||
+                a_operation == operation::modulo;
+        }
+
+        constexpr bool is_bitwise_operation(operation const a_operation) noexcept {
+            return
+                a_operation == operation::bitwise_and ||
+                a_operation == operation::bitwise_or  ||
+                a_operation == operation::bitwise_xor;
+        }
+
+        constexpr bool is_ordering_operation(operation const a_operation) noexcept {
+            return
+                a_operation == operation::lesser          ||
+                a_operation == operation::lesser_equality ||
+                a_operation == operation::greater         ||
+                a_operation == operation::greater_equality;
+        }
+
+        object boolean_object(bool const a_value) noexcept {
+            return object(a_value ? _true : _false);
+        }
+
+        [[noreturn]]
+        void throw_undefined_operation(operation const a_operation, type const a_lhs, type const a_rhs) {
+            throw std::invalid_argument(fmt::format(
+                "Operation {} is not defined for types {} and {}.",
+                operation_as_string(a_operation),
+                type_as_string(a_lhs),
+                type_as_string(a_rhs)
+            ));
+        }
+
+        template <type v_type>
+        number numeric_value(object const & a_object) noexcept {
+            if constexpr (v_type == type::integer) {
+                return static_cast<number>(a_object.get_integer());
+            } else {
+                return a_object.get_number();
+            }
+        }
+
+        template <operation v_operation>
+        object number_arithmetic(number const a_lhs, number const a_rhs) {
+            if constexpr (v_operation == operation::addition) {
+                return object(a_lhs + a_rhs);
+            }
+            else if constexpr (v_operation == operation::subtraction) {
+                return object(a_lhs - a_rhs);
+            }
+            else if constexpr (v_operation == operation::multiplication) {
+                return object(a_lhs * a_rhs);
+            }
+            else if constexpr (v_operation == operation::division) {
+                return object(a_lhs / a_rhs);
+            }
+            else if constexpr (v_operation == operation::exponentiation) {
+                return object(std::pow(a_lhs, a_rhs));
+            }
+            else {
+                return object(std::fmod(a_lhs, a_rhs));
+            }
+        }
+
+        template <operation v_operation>
+        object integer_arithmetic(integer const a_lhs, integer const a_rhs) {
+            integer result;
+
+            if constexpr (v_operation == operation::addition) {
+                if (!__builtin_add_overflow(a_lhs, a_rhs, &result)) {
+                    return object(result);
+                }
+            }
+            else if constexpr (v_operation == operation::subtraction) {
+                if (!__builtin_sub_overflow(a_lhs, a_rhs, &result)) {
+                    return object(result);
+                }
+            }
+            else if constexpr (v_operation == operation::multiplication) {
+                if (!__builtin_mul_overflow(a_lhs, a_rhs, &result)) {
+                    return object(result);
+                }
+            }
+            else if constexpr (v_operation == operation::exponentiation) {
+                // Exponentiation by squaring, falling back to floating point
+                // on overflow or negative exponents.
+                if (a_rhs >= 0) {
+                    integer base = a_lhs;
+                    integer exponent = a_rhs;
+                    bool overflow = false;
+
+                    result = 1;
+
+                    while (exponent != 0 && !overflow) {
+                        if (exponent & 1) {
+                            overflow = __builtin_mul_overflow(result, base, &result);
+                        }
+
+                        exponent >>= 1;
+
+                        if (exponent != 0) {
+                            overflow = overflow || __builtin_mul_overflow(base, base, &base);
+                        }
+                    }
+
+                    if (!overflow) {
+                        return object(result);
+                    }
+                }
+            }
+            else if constexpr (v_operation == operation::modulo) {
+                if (a_rhs == 0) {
+                    throw std::domain_error("Integer modulo by zero.");
+                }
+
+                // Avoid overflow of the lowest integer modulo -1.
+                return object(a_rhs == -1 ? integer(0) : a_lhs % a_rhs);
+            }
+
+            // Division always produces a number, as do results that overflow.
+            return number_arithmetic<v_operation>(static_cast<number>(a_lhs), static_cast<number>(a_rhs));
+        }
+
+        template <operation v_operation, typename t_value>
+        object ordering(t_value const & a_lhs, t_value const & a_rhs) noexcept {
+            if constexpr (v_operation == operation::lesser) {
+                return boolean_object(a_lhs < a_rhs);
+            }
+            else if constexpr (v_operation == operation::lesser_equality) {
+                return boolean_object(a_lhs <= a_rhs);
+            }
+            else if constexpr (v_operation == operation::greater) {
+                return boolean_object(a_lhs > a_rhs);
+            }
+            else {
+                return boolean_object(a_lhs >= a_rhs);
+            }
+        }
+
+        /**
+         * Order an integer and a number exactly; converting the integer to a
+         * number would round it once it exceeds the mantissa.
+         */
+        template <operation v_operation, type v_lhs, type v_rhs>
+        object mixed_ordering(object const & a_lhs, object const & a_rhs) noexcept {
+            std::partial_ordering const order = [&] {
+                if constexpr (v_lhs == type::integer) {
+                    return compare_integer_number(a_lhs.get_integer(), a_rhs.get_number());
+                } else {
+                    return 0 <=> compare_integer_number(a_rhs.get_integer(), a_lhs.get_number());
+                }
+            }();
+
+            if constexpr (v_operation == operation::lesser) {
+                return boolean_object(order < 0);
+            }
+            else if constexpr (v_operation == operation::lesser_equality) {
+                return boolean_object(order <= 0);
+            }
+            else if constexpr (v_operation == operation::greater) {
+                return boolean_object(order > 0);
+            }
+            else {
+                return boolean_object(order >= 0);
+            }
+        }
+
+        template <type v_lhs, type v_rhs>
+        bool equal(object const & a_lhs, object const & a_rhs) noexcept {
+            if constexpr (v_lhs == type::integer && v_rhs == type::integer) {
+                return a_lhs.get_integer() == a_rhs.get_integer();
+            }
+            else if constexpr (v_lhs == type::integer && v_rhs == type::number) {
+                return integer_equals_number(a_lhs.get_integer(), a_rhs.get_number());
+            }
+            else if constexpr (v_lhs == type::number && v_rhs == type::integer) {
+                return integer_equals_number(a_rhs.get_integer(), a_lhs.get_number());
+            }
+            else if constexpr (v_lhs == type::number && v_rhs == type::number) {
+                return a_lhs.get_number() == a_rhs.get_number();
+            }
+            else if constexpr (v_lhs != v_rhs) {
+                return false;
+            }
+            else if constexpr (v_lhs == type::null) {
+                return true;
+            }
+            else if constexpr (v_lhs == type::boolean) {
+                return a_lhs.get_boolean() == a_rhs.get_boolean();
+            }
+            else if constexpr (v_lhs == type::string) {
+                // Strings are interned, so equal strings share their storage
+                // unless one of them is frozen.
+                return a_lhs.identical(a_rhs) || a_lhs.equals(a_rhs);
+            }
+            else if constexpr (static_cast<std::uint64_t>(v_lhs) >= complexly_comparable_threshold) {
+                return a_lhs.equals(a_rhs);
+            }
+            else {
+                return a_lhs.identical(a_rhs);
+            }
+        }
+
+        /**
+         * Perform an operation on a specific pair of types. One instance of
+         * this handler exists for every entry of the dispatch matrix.
+         */
+        template <operation v_operation, type v_lhs, type v_rhs>
+        object operation_handler_for(object const & a_lhs, object const & a_rhs) {
+            if constexpr (v_operation == operation::equality) {
+                return boolean_object(equal<v_lhs, v_rhs>(a_lhs, a_rhs));
+            }
+            else if constexpr (is_arithmetic_operation(v_operation) && v_lhs == type::integer && v_rhs == type::integer) {
+                return integer_arithmetic<v_operation>(a_lhs.get_integer(), a_rhs.get_integer());
+            }
+            else if constexpr (is_arithmetic_operation(v_operation) && is_numeric_type(v_lhs) && is_numeric_type(v_rhs)) {
+                return number_arithmetic<v_operation>(numeric_value<v_lhs>(a_lhs), numeric_value<v_rhs>(a_rhs));
+            }
+            else if constexpr (v_operation == operation::addition && v_lhs == type::string && v_rhs == type::string) {
+                // String concatenation.
+                std::string concatenated;
+                concatenated.reserve(a_lhs.string_view().size() + a_rhs.string_view().size());
+                concatenated += a_lhs.string_view();
+                concatenated += a_rhs.string_view();
+
+                // Intern the result in the engine of a string that has one.
+                auto const & owned = a_lhs.is_frozen() ? a_rhs : a_lhs;
+
+                if (owned.is_frozen()) [[unlikely]] {
+                    throw std::invalid_argument("Frozen strings cannot be concatenated outside of an environment.");
+                }
+
+                return object(owned.get_string().parent_engine().str(concatenated));
+            }
+            else if constexpr (is_bitwise_operation(v_operation) && v_lhs == v_rhs && (v_lhs == type::integer || v_lhs == type::boolean)) {
+                auto const lhs = v_lhs == type::integer ? a_lhs.get_integer() : static_cast<integer>(a_lhs.get_boolean());
+                auto const rhs = v_lhs == type::integer ? a_rhs.get_integer() : static_cast<integer>(a_rhs.get_boolean());
+
+                integer result;
+
+                if constexpr (v_operation == operation::bitwise_and) {
+                    result = lhs & rhs;
+                }
+                else if constexpr (v_operation == operation::bitwise_or) {
+                    result = lhs | rhs;
+                }
+                else {
+                    result = lhs ^ rhs;
+                }
+
+                if constexpr (v_lhs == type::boolean) {
+                    return object(static_cast<boolean>(result));
+                } else {
+                    return object(result);
+                }
+            }
+            else if constexpr (is_ordering_operation(v_operation) && v_lhs == type::integer && v_rhs == type::integer) {
+                return ordering<v_operation>(a_lhs.get_integer(), a_rhs.get_integer());
+            }
+            else if constexpr (is_ordering_operation(v_operation) && v_lhs == type::number && v_rhs == type::number) {
+                return ordering<v_operation>(a_lhs.get_number(), a_rhs.get_number());
+            }
+            else if constexpr (is_ordering_operation(v_operation) && is_numeric_type(v_lhs) && is_numeric_type(v_rhs)) {
+                return mixed_ordering<v_operation, v_lhs, v_rhs>(a_lhs, a_rhs);
+            }
+            else if constexpr (is_ordering_operation(v_operation) && v_lhs == type::string && v_rhs == type::string) {
+                return ordering<v_operation>(a_lhs.string_view(), a_rhs.string_view());
+            }
+            else {
+                throw_undefined_operation(v_operation, v_lhs, v_rhs);
+            }
+        }
+
+        constexpr std::size_t type_pair_count = type_count * type_count;
+
+        /**
+         * The dense dispatch matrix, indexed by
+         * [operation index][left-hand type][right-hand type].
+         */
+        constexpr auto dispatch_matrix = []<std::size_t ...v_indices>(std::index_sequence<v_indices...>) {
+            return std::array<operation_handler, sizeof...(v_indices)>{
+                &operation_handler_for<
+                    dispatched_operations[v_indices / type_pair_count],
+                    static_cast<type>(v_indices / type_count % type_count),
+                    static_cast<type>(v_indices % type_count)
+                >...
+            };
+        }(std::make_index_sequence<dispatched_operation_count * type_pair_count>{});
+
+    }
+
+    operation_handler operation_dispatch(std::size_t const a_operation_index, type const a_lhs, type const a_rhs) noexcept {
+        return dispatch_matrix[
+            a_operation_index * type_pair_count +
+            static_cast<std::size_t>(a_lhs) * type_count +
+            static_cast<std::size_t>(a_rhs)
+        ];
+    }
+
+    object perform_operation(operation const a_operation, object const & a_lhs, object const & a_rhs) {
+        auto const operation_index = dispatched_operation_index(a_operation);
+
+        if (operation_index == dispatched_operation_count) [[unlikely]] {
+            throw_undefined_operation(a_operation, a_lhs.object_type(), a_rhs.object_type());
+        }
+
+        return operation_dispatch(operation_index, a_lhs.object_type(), a_rhs.object_type())(a_lhs, a_rhs);
+    }
+
+}
@@ -0,0 +1,629 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <fmt/format.h>
+
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <rebar/environment/serialization.hpp>
+#include <rebar/environment/array.hpp>
+#include <rebar/environment/frozen.hpp>
+#include <rebar/environment/table.hpp>
+
+namespace rebar {
+
+    namespace {
+
+        struct graph_header {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint64_t string_count;
+            std::uint64_t strings_offset; ///< Offset of the string table.
+            std::uint64_t shape_count;
+            std::uint64_t shapes_offset;  ///< Offset of the shape offset table.
+            std::uint64_t root_type;
+            std::uint64_t root_data;
+        };
+
+        struct encoded_value {
+            std::uint64_t type;
+            std::uint64_t data;
+
+            auto operator <=> (encoded_value const &) const noexcept = default;
+        };
+
+        struct string_entry {
+            std::uint64_t offset;
+            std::uint64_t length;
+        };
+
+        struct array_node {
+            std::uint64_t storage;
+            std::uint64_t length;
+        };
+
+        struct table_node {
+            std::uint64_t shape;
+            std::uint64_t count;
+        };
+
+        constexpr std::size_t graph_alignment = 8;
+
+        [[noreturn]]
+        void throw_malformed(std::string_view const a_reason) {
+            throw std::runtime_error(fmt::format("Malformed object graph: {}.", a_reason));
+        }
+
+    }
+
+    /**
+     * Writes object graphs in the binary object graph format. Nodes are
+     * written after their children, so that every node refers to the
+     * offsets of nodes that were already written.
+     */
+    class graph_writer {
+        std::vector<std::byte> m_output;
+
+        std::unordered_map<void const *, std::uint64_t>      m_nodes;
+        std::unordered_map<std::string_view, std::uint64_t>  m_string_indices;
+        std::vector<std::string_view>                        m_strings;
+        std::map<std::vector<encoded_value>, std::uint64_t> m_shape_indices;
+
+    public:
+        [[nodiscard]]
+        std::vector<std::byte> write(object const & a_root) {
+            m_output.resize(sizeof(graph_header));
+
+            auto const root = encode(a_root);
+
+            // String characters, then the string table.
+            std::vector<string_entry> string_table;
+            string_table.reserve(m_strings.size());
+
+            for (auto const string : m_strings) {
+                string_table.push_back({ append_bytes(string.data(), string.size()), string.size() });
+            }
+
+            align();
+            auto const strings_offset = append_bytes(string_table.data(), string_table.size() * sizeof(string_entry));
+
+            // Shapes, then the shape offset table.
+            std::vector<std::uint64_t> shape_offsets(m_shape_indices.size());
+
+            for (auto const & [keys, index] : m_shape_indices) {
+                align();
+
+                std::uint64_t const count = keys.size();
+                shape_offsets[index] = append_bytes(&count, sizeof(count));
+                append_bytes(keys.data(), keys.size() * sizeof(encoded_value));
+            }
+
+            auto const shapes_offset = append_bytes(shape_offsets.data(), shape_offsets.size() * sizeof(std::uint64_t));
+
+            graph_header const header{
+                .magic          = graph_magic,
+                .version        = graph_format_version,
+                .string_count   = m_strings.size(),
+                .strings_offset = strings_offset,
+                .shape_count    = shape_offsets.size(),
+                .shapes_offset  = shapes_offset,
+                .root_type      = root.type,
+                .root_data      = root.data,
+            };
+
+            std::memcpy(m_output.data(), &header, sizeof(header));
+
+            return std::move(m_output);
+        }
+
+    private:
+        [[nodiscard]]
+        encoded_value encode(object const & a_object) {
+            auto const object_type = static_cast<std::uint64_t>(a_object.m_type);
+
+            switch (a_object.m_type) {
+                case type::null:
+                case type::boolean:
+                case type::integer:
+                case type::number:
+                    return { object_type, a_object.m_data };
+                case type::string: {
+                    auto const string = a_object.string_view();
+                    auto const [it, inserted] = m_string_indices.try_emplace(string, m_strings.size());
+
+                    if (inserted) {
+                        m_strings.push_back(string);
+                    }
+
+                    return { object_type, it->second };
+                }
+                case type::array:
+                    return { object_type, write_array(*a_object.as_internal_array()) };
+                case type::table:
+                    return { object_type, write_table(*a_object.as_internal_table()) };
+                default:
+                    throw std::invalid_argument(fmt::format(
+                        "Objects of type {} cannot be serialized.",
+                        type_as_string(a_object.m_type)
+                    ));
+            }
+        }
+
+        [[nodiscard]]
+        std::uint64_t write_array(internal_array const & a_array) {
+            if (auto const it = m_nodes.find(&a_array); it != m_nodes.cend()) {
+                return it->second;
+            }
+
+            auto const length = a_array.length();
+
+            // Store arrays of a single numeric type raw.
+            auto storage = a_array.storage;
+
+            if (storage == array_storage::objects && length != 0) {
+                auto const all_of_type = [&a_array](type const a_type) {
+                    return std::ranges::all_of(a_array.elements, [a_type](object const & a_element) {
+                        return a_element.is_type(a_type);
+                    });
+                };
+
+                if (all_of_type(type::integer)) {
+                    storage = array_storage::integers;
+                } else if (all_of_type(type::number)) {
+                    storage = array_storage::numbers;
+                }
+            }
+
+            std::uint64_t offset;
+
+            if (storage == array_storage::objects) {
+                std::vector<encoded_value> values;
+                values.reserve(length);
+
+                for (auto const & element : a_array.elements) {
+                    values.push_back(encode(element));
+                }
+
+                offset = append_node(array_node{ static_cast<std::uint64_t>(storage), length });
+                append_bytes(values.data(), values.size() * sizeof(encoded_value));
+            } else {
+                offset = append_node(array_node{ static_cast<std::uint64_t>(storage), length });
+
+                if (a_array.storage == storage) {
+                    append_bytes(a_array.view, length * sizeof(std::uint64_t));
+                } else {
+                    for (auto const & element : a_array.elements) {
+                        append_bytes(&element.m_data, sizeof(element.m_data));
+                    }
+                }
+            }
+
+            m_nodes.emplace(&a_array, offset);
+
+            return offset;
+        }
+
+        [[nodiscard]]
+        std::uint64_t write_table(internal_table const & a_table) {
+            if (auto const it = m_nodes.find(&a_table); it != m_nodes.cend()) {
+                return it->second;
+            }
+
+            std::vector<std::pair<encoded_value, encoded_value>> entries;
+            entries.reserve(a_table.entries.size());
+
+            for (auto const & entry : a_table.entries) {
+                entries.emplace_back(encode(entry.key), encode(entry.value));
+            }
+
+            // Sort entries by key so that tables with equal keys share a shape.
+            std::ranges::sort(entries, {}, &std::pair<encoded_value, encoded_value>::first);
+
+            std::vector<encoded_value> keys;
+            std::vector<encoded_value> slots;
+
+            keys.reserve(entries.size());
+            slots.reserve(entries.size());
+
+            for (auto const & [key, value] : entries) {
+                keys.push_back(key);
+                slots.push_back(value);
+            }
+
+            auto const shape = m_shape_indices.try_emplace(std::move(keys), m_shape_indices.size()).first->second;
+
+            auto const offset = append_node(table_node{ shape, slots.size() });
+            append_bytes(slots.data(), slots.size() * sizeof(encoded_value));
+
+            m_nodes.emplace(&a_table, offset);
+
+            return offset;
+        }
+
+        template <typename t_node>
+        [[nodiscard]]
+        std::uint64_t append_node(t_node const & a_node) {
+            align();
+            return append_bytes(&a_node, sizeof(a_node));
+        }
+
+        std::uint64_t append_bytes(void const * const a_data, std::size_t const a_size) {
+            auto const offset = m_output.size();
+
+            m_output.resize(offset + a_size);
+
+            if (a_size != 0) {
+                std::memcpy(m_output.data() + offset, a_data, a_size);
+            }
+
+            return offset;
+        }
+
+        void align() {
+            m_output.resize((m_output.size() + graph_alignment - 1) / graph_alignment * graph_alignment);
+        }
+    };
+
+    std::vector<std::byte> serialize_graph(object const & a_object) {
+        return graph_writer{}.write(a_object);
+    }
+
+    void write_graph(object const & a_object, std::filesystem::path const & a_path) {
+        auto const data = serialize_graph(a_object);
+
+        std::ofstream stream(a_path, std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<char const *>(data.data()), static_cast<std::streamsize>(data.size()));
+
+        if (!stream) {
+            throw std::runtime_error(fmt::format("Failed to write object graph to \"{}\".", a_path.string()));
+        }
+    }
+
+    struct frozen_graph::load_state {
+        std::span<std::byte const> data;
+        arena &                    target;
+
+        std::vector<internal_string *>                 strings       = {};
+        std::span<std::uint64_t const>                 shape_offsets = {};
+        std::unordered_map<std::uint64_t, object>      nodes         = {};
+        std::unordered_set<std::uint64_t>              loading       = {}; ///< Nodes being loaded (cycle detection).
+
+        /**
+         * View an array of values in the data, checking bounds and alignment.
+         */
+        template <typename t_value>
+        [[nodiscard]]
+        std::span<t_value const> view(std::uint64_t const a_offset, std::uint64_t const a_count) const {
+            if (a_offset % alignof(t_value) != 0 || a_offset > data.size() || a_count > (data.size() - a_offset) / sizeof(t_value)) {
+                throw_malformed("section out of bounds");
+            }
+
+            return { reinterpret_cast<t_value const *>(data.data() + a_offset), static_cast<std::size_t>(a_count) };
+        }
+
+        /**
+         * View the encoded children of an array or table node: the keys of
+         * its shape and its slots for tables, and the elements of arrays of
+         * objects (typed arrays have none).
+         */
+        [[nodiscard]]
+        std::pair<std::span<encoded_value const>, std::span<encoded_value const>> node_values(std::uint64_t const a_offset, type const a_type) const {
+            if (a_type == type::array) {
+                auto const & node = view<array_node>(a_offset, 1).front();
+
+                switch (static_cast<array_storage>(node.storage)) {
+                    case array_storage::objects:
+                        return { {}, view<encoded_value>(a_offset + sizeof(array_node), node.length) };
+                    case array_storage::integers:
+                    case array_storage::numbers:
+                        return {};
+                    default:
+                        throw_malformed("invalid array storage");
+                }
+            }
+
+            auto const & node = view<table_node>(a_offset, 1).front();
+
+            if (node.shape >= shape_offsets.size()) {
+                throw_malformed("shape index out of bounds");
+            }
+
+            auto const shape_offset = shape_offsets[node.shape];
+            auto const key_count = view<std::uint64_t>(shape_offset, 1).front();
+
+            if (key_count != node.count) {
+                throw_malformed("table does not match its shape");
+            }
+
+            return {
+                view<encoded_value>(shape_offset + sizeof(std::uint64_t), key_count),
+                view<encoded_value>(a_offset + sizeof(table_node), node.count),
+            };
+        }
+    };
+
+    frozen_graph frozen_graph::load(std::span<std::byte const> const a_data, std::shared_ptr<void const> a_storage) {
+        if (reinterpret_cast<std::uintptr_t>(a_data.data()) % graph_alignment != 0) {
+            throw std::runtime_error("Serialized object graphs must be aligned to 8 bytes.");
+        }
+
+        auto target = std::make_unique<arena>();
+        load_state state{ a_data, *target };
+
+        auto const & header = state.view<graph_header>(0, 1).front();
+
+        if (header.magic != graph_magic) {
+            throw_malformed("invalid magic number");
+        }
+
+        if (header.version != graph_format_version) {
+            throw_malformed("unsupported version");
+        }
+
+        // Strings view their characters in the data.
+        auto const string_table = state.view<string_entry>(header.strings_offset, header.string_count);
+        state.strings.reserve(string_table.size());
+
+        for (auto const & entry : string_table) {
+            auto const characters = state.view<char>(entry.offset, entry.length);
+            std::string_view const string(characters.data(), characters.size());
+
+            state.strings.push_back(target->construct<internal_string>(
+                immortal_reference_count,
+                nullptr,
+                std::hash<std::string_view>{}(string),
+                string
+            ));
+        }
+
+        state.shape_offsets = state.view<std::uint64_t>(header.shapes_offset, header.shape_count);
+
+        auto root = load_object(state, header.root_type, header.root_data);
+
+        return { std::move(a_storage), std::move(target), std::move(root) };
+    }
+
+    frozen_graph frozen_graph::load_file(std::filesystem::path const & a_path) {
+        auto const fail = [&a_path](std::string_view const a_reason) {
+            throw std::runtime_error(fmt::format("Failed to map object graph \"{}\": {}.", a_path.string(), a_reason));
+        };
+
+#if defined(_WIN32)
+        std::ifstream stream(a_path, std::ios::binary);
+
+        if (!stream) {
+            fail("cannot open file");
+        }
+
+        auto const contents = std::make_shared<std::vector<std::byte>>();
+
+        for (auto it = std::istreambuf_iterator<char>(stream); it != std::istreambuf_iterator<char>(); ++it) {
+            contents->push_back(static_cast<std::byte>(*it));
+        }
+
+        std::span<std::byte const> const data(*contents);
+        return load(data, std::move(contents));
+#else
+        int const descriptor = ::open(a_path.c_str(), O_RDONLY);
+
+        if (descriptor == -1) {
+            fail("cannot open file");
+        }
+
+        struct stat status{};
+
+        if (::fstat(descriptor, &status) == -1 || status.st_size == 0) {
+            ::close(descriptor);
+            fail("cannot read file size");
+        }
+
+        auto const size = static_cast<std::size_t>(status.st_size);
+        void * const mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+        ::close(descriptor);
+
+        if (mapping == MAP_FAILED) {
+            fail("cannot map file");
+        }
+
+        std::shared_ptr<void const> storage(mapping, [size](void const * const a_mapping) {
+            ::munmap(const_cast<void *>(a_mapping), size);
+        });
+
+        return load({ static_cast<std::byte const *>(mapping), size }, std::move(storage));
+#endif
+    }
+
+    object frozen_graph::load_object(load_state & a_state, std::uint64_t const a_type, std::uint64_t const a_data) {
+        if (auto value = loaded_value(a_state, a_type, a_data)) {
+            return *std::move(value);
+        }
+
+        /// A node whose children are being loaded.
+        struct pending_node {
+            std::uint64_t offset;
+            type          node_type;
+            std::size_t   next_child = 0; ///< Index of the next child to load, keys before slots.
+        };
+
+        // Load nodes depth first with an explicit stack, so that deeply
+        // nested graphs cannot overflow the call stack. Each node is
+        // constructed once all of its children have been.
+        std::vector<pending_node> pending;
+        pending.push_back({ a_data, static_cast<type>(a_type) });
+        a_state.loading.insert(a_data);
+
+        while (!pending.empty()) {
+            auto & node = pending.back();
+            auto const [keys, values] = a_state.node_values(node.offset, node.node_type);
+            auto const child_count = keys.size() + values.size();
+
+            bool descended = false;
+
+            while (node.next_child < child_count) {
+                auto const & child = node.next_child < keys.size() ? keys[node.next_child] : values[node.next_child - keys.size()];
+                ++node.next_child;
+
+                if (loaded_value(a_state, child.type, child.data)) {
+                    continue;
+                }
+
+                if (!a_state.loading.insert(child.data).second) {
+                    throw_malformed("cyclic nodes");
+                }
+
+                // Invalidates node.
+                pending.push_back({ child.data, static_cast<type>(child.type) });
+                descended = true;
+
+                break;
+            }
+
+            if (descended) {
+                continue;
+            }
+
+            auto const offset = node.offset;
+            auto result = load_node(a_state, offset, node.node_type);
+
+            pending.pop_back();
+
+            a_state.loading.erase(offset);
+            a_state.nodes.emplace(offset, std::move(result));
+        }
+
+        return a_state.nodes.at(a_data);
+    }
+
+    std::optional<object> frozen_graph::loaded_value(load_state & a_state, std::uint64_t const a_type, std::uint64_t const a_data) {
+        if (a_type >= type_count) {
+            throw_malformed("invalid type");
+        }
+
+        auto const object_type = static_cast<type>(a_type);
+
+        if (object_type == type::string) {
+            if (a_data >= a_state.strings.size()) {
+                throw_malformed("string index out of bounds");
+            }
+
+            return object(type::string, std::bit_cast<object_data>(a_state.strings[a_data]));
+        }
+
+        if (object_type != type::array && object_type != type::table) {
+            if (static_cast<std::uint64_t>(object_type) >= complex_type_threshold) {
+                throw_malformed(fmt::format("unexpected {} value", type_as_string(object_type)));
+            }
+
+            return object(object_type, a_data);
+        }
+
+        if (auto const it = a_state.nodes.find(a_data); it != a_state.nodes.cend()) {
+            if (it->second.m_type != object_type) {
+                throw_malformed("conflicting node types");
+            }
+
+            return it->second;
+        }
+
+        return std::nullopt;
+    }
+
+    object frozen_graph::load_node(load_state & a_state, std::uint64_t const a_offset, type const a_type) {
+        auto const [keys, values] = a_state.node_values(a_offset, a_type);
+
+        // Every child has been loaded by now.
+        auto const child = [&a_state](encoded_value const & a_value) {
+            return *loaded_value(a_state, a_value.type, a_value.data);
+        };
+
+        if (a_type == type::array) {
+            auto const & node = a_state.view<array_node>(a_offset, 1).front();
+
+            if (static_cast<array_storage>(node.storage) == array_storage::objects) {
+                auto * const array = a_state.target.construct<internal_array>(
+                    immortal_reference_count,
+                    nullptr,
+                    std::pmr::vector<object>(&a_state.target)
+                );
+
+                array->elements.reserve(values.size());
+
+                for (auto const & value : values) {
+                    array->elements.push_back(child(value));
+                }
+
+                object loaded{ type::array, std::bit_cast<object_data>(array) };
+
+                // The children's hashes are already memoized, so this only
+                // hashes the node itself.
+                array->hash = loaded.hash();
+                array->hash_cached = true;
+
+                return loaded;
+            }
+
+            // Typed arrays view their elements in the data.
+            auto const elements = a_state.view<std::uint64_t>(a_offset + sizeof(array_node), node.length);
+
+            auto * const array = a_state.target.construct<internal_array>(
+                immortal_reference_count,
+                nullptr,
+                std::pmr::vector<object>(&a_state.target),
+                0ull,
+                false,
+                static_cast<array_storage>(node.storage),
+                elements.data(),
+                elements.size()
+            );
+
+            object loaded{ type::array, std::bit_cast<object_data>(array) };
+
+            array->hash = loaded.hash();
+            array->hash_cached = true;
+
+            return loaded;
+        }
+
+        auto * const table = a_state.target.construct<internal_table>(
+            immortal_reference_count,
+            nullptr,
+            compact_table(values.size(), &a_state.target)
+        );
+
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            auto key = child(keys[i]);
+
+            if (key.is_null()) {
+                throw_malformed("null table key");
+            }
+
+            table->entries.insert_or_assign(std::move(key), child(values[i]));
+        }
+
+        object loaded{ type::table, std::bit_cast<object_data>(table) };
+
+        table->hash = loaded.hash();
+        table->hash_cached = true;
+
+        return loaded;
+    }
+
+}
@@ -0,0 +1,541 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <rebar/environment/table.hpp>
+#include <rebar/util/hash.hpp>
+
+namespace rebar {
+
+    namespace {
+
+        /// Smallest amount of index slots allocated for a table.
+        constexpr std::size_t minimum_index_capacity = 8;
+
+        /**
+         * Amount of entries (including tombstones) a table may hold before
+         * its index must grow, keeping the index at most two thirds full.
+         */
+        constexpr std::size_t usable_capacity(std::size_t const a_index_capacity) noexcept {
+            return a_index_capacity * 2 / 3;
+        }
+
+        /**
+         * Widen a stored index slot, mapping its two largest values to the
+         * empty and removed markers.
+         */
+        template <typename t_index>
+        std::size_t widen_slot(t_index const a_value) noexcept {
+            constexpr auto limit = std::numeric_limits<t_index>::max();
+            return a_value >= limit - 1 ? SIZE_MAX - (limit - a_value) : a_value;
+        }
+
+        /// Integral numbers above this bound may not be exactly representable.
+        constexpr number maximum_element_number = 9007199254740992.0;
+
+        /// An entry of a weak table weakly holding an object.
+        struct weak_reference {
+            compact_table * holder;
+            std::size_t     hash; ///< Hash of the key of the entry.
+        };
+
+        /// Registry of weakly held objects, keyed by their payloads.
+        std::mutex                                                  g_weak_mutex;
+        std::unordered_multimap<void const *, weak_reference>       g_weak_references;
+        std::atomic<std::size_t>                                    g_weak_reference_count = 0;
+
+        void register_weak_reference(void const * const a_referent, compact_table * const a_holder, std::size_t const a_hash) noexcept {
+            std::lock_guard const lock(g_weak_mutex);
+
+            g_weak_references.emplace(a_referent, weak_reference{ a_holder, a_hash });
+            g_weak_reference_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void unregister_weak_reference(void const * const a_referent, compact_table const * const a_holder, std::size_t const a_hash) noexcept {
+            std::lock_guard const lock(g_weak_mutex);
+
+            auto [it, end] = g_weak_references.equal_range(a_referent);
+
+            for (; it != end; ++it) {
+                if (it->second.holder == a_holder && it->second.hash == a_hash) {
+                    g_weak_references.erase(it);
+                    g_weak_reference_count.fetch_sub(1, std::memory_order_relaxed);
+
+                    return;
+                }
+            }
+        }
+
+    }
+
+    void release_weak_references(void const * const a_referent) noexcept {
+        if (g_weak_reference_count.load(std::memory_order_relaxed) == 0) [[likely]] {
+            return;
+        }
+
+        // Remove one entry at a time, as removing an entry may destroy other
+        // weak tables, which unregister their own entries.
+        while (true) {
+            weak_reference reference{};
+
+            {
+                std::lock_guard const lock(g_weak_mutex);
+
+                auto const it = g_weak_references.find(a_referent);
+
+                if (it == g_weak_references.cend()) {
+                    return;
+                }
+
+                reference = it->second;
+
+                g_weak_references.erase(it);
+                g_weak_reference_count.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            reference.holder->remove_weak(a_referent, reference.hash);
+        }
+    }
+
+    compact_table::compact_table(std::size_t const a_reserve, std::pmr::memory_resource * const a_resource) :
+        compact_table(a_resource)
+    {
+        reserve(a_reserve);
+    }
+
+    compact_table::compact_table(compact_table const & a_table, std::pmr::memory_resource * const a_resource) :
+        compact_table(a_table.m_mode, a_resource)
+    {
+        reserve(a_table.m_size);
+
+        m_elements.assign(a_table.m_elements.cbegin(), a_table.m_elements.cend());
+        m_element_count = a_table.m_element_count;
+
+        for (auto const & entry : a_table.m_entries) {
+            if (!entry.key.is_null()) {
+                m_entries.push_back(entry);
+                link(m_entries.size() - 1);
+            }
+        }
+
+        m_size = a_table.m_size;
+
+        // The copies of weak components are strong until given up.
+        if (m_mode != table_mode::strong) {
+            for (auto & entry : m_entries) {
+                hold_weakly(weak_component(entry), entry.hash);
+            }
+        }
+    }
+
+    compact_table::compact_table(compact_table && a_table) noexcept :
+        m_elements(std::move(a_table.m_elements)),
+        m_element_count(std::exchange(a_table.m_element_count, 0)),
+        m_entries(std::move(a_table.m_entries)),
+        m_resource(a_table.m_resource),
+        m_index(std::exchange(a_table.m_index, nullptr)),
+        m_index_capacity(std::exchange(a_table.m_index_capacity, 0)),
+        m_index_width(std::exchange(a_table.m_index_width, 0)),
+        m_size(std::exchange(a_table.m_size, 0)),
+        m_mode(a_table.m_mode)
+    {
+        if (m_mode == table_mode::strong) {
+            return;
+        }
+
+        for (auto & entry : m_entries) {
+            if (auto const & component = weak_component(entry); !entry.key.is_null() && weakly_holdable(component)) {
+                auto const * const referent = std::bit_cast<void const *>(component.m_data);
+
+                unregister_weak_reference(referent, &a_table, entry.hash);
+                register_weak_reference(referent, this, entry.hash);
+            }
+        }
+    }
+
+    compact_table::~compact_table() noexcept {
+        if (m_mode != table_mode::strong) {
+            for (auto & entry : m_entries) {
+                if (!entry.key.is_null()) {
+                    release_weak(weak_component(entry), entry.hash);
+                }
+            }
+        }
+
+        release_index();
+    }
+
+    object const * compact_table::find(object const & a_key) const {
+        if (auto const position = array_position(a_key); position < m_elements.size()) {
+            auto const & element = m_elements[position];
+            return element.is_null() ? nullptr : &element;
+        }
+
+        if (m_size == 0) {
+            return nullptr;
+        }
+
+        auto const slot = find_slot(a_key, key_hash(a_key));
+
+        if (slot == empty_slot) {
+            return nullptr;
+        }
+
+        return &m_entries[slot_value(slot)].value;
+    }
+
+    void compact_table::insert_or_assign(object a_key, object a_value) {
+        // The hash part never holds the keys [0, m_elements.size()].
+        if (auto const position = array_position(a_key); position < m_elements.size()) {
+            auto & element = m_elements[position];
+
+            if (element.is_null()) {
+                ++m_element_count;
+            }
+
+            element = std::move(a_value);
+            return;
+        } else if (position == m_elements.size()) {
+            append_element(std::move(a_value));
+            return;
+        }
+
+        auto const hash = key_hash(a_key);
+
+        if (m_size != 0) {
+            if (auto const slot = find_slot(a_key, hash); slot != empty_slot) {
+                auto & entry = m_entries[slot_value(slot)];
+
+                if (m_mode != table_mode::weak_values) {
+                    entry.value = std::move(a_value);
+                    return;
+                }
+
+                // An entry weakly holding a value that is referenced nowhere
+                // else disappears immediately.
+                if (held_only_here(a_value)) {
+                    erase_entry(a_key, hash);
+                    return;
+                }
+
+                release_weak(entry.value, hash);
+                entry.value = std::move(a_value);
+                hold_weakly(entry.value, hash);
+
+                return;
+            }
+        }
+
+        if (m_mode != table_mode::strong && held_only_here(m_mode == table_mode::weak_keys ? a_key : a_value)) {
+            return;
+        }
+
+        // Tombstones occupy index slots too, so they count towards the load.
+        if (m_entries.size() >= usable_capacity(m_index_capacity)) {
+            rebuild(std::max<std::size_t>(m_size * 2, 1));
+        }
+
+        m_entries.push_back({ hash, std::move(a_key), std::move(a_value) });
+        link(m_entries.size() - 1);
+
+        ++m_size;
+
+        if (m_mode != table_mode::strong) {
+            hold_weakly(weak_component(m_entries.back()), hash);
+        }
+    }
+
+    bool compact_table::erase(object const & a_key) {
+        if (auto const position = array_position(a_key); position < m_elements.size()) {
+            auto & element = m_elements[position];
+
+            if (element.is_null()) {
+                return false;
+            }
+
+            element = object();
+            --m_element_count;
+
+            // Trim absent keys from the end of the array part.
+            while (!m_elements.empty() && m_elements.back().is_null()) {
+                m_elements.pop_back();
+            }
+
+            return true;
+        }
+
+        if (m_size == 0) {
+            return false;
+        }
+
+        return !erase_entry(a_key, key_hash(a_key)).is_null();
+    }
+
+    void compact_table::reserve(std::size_t const a_reserve) {
+        if (a_reserve > usable_capacity(m_index_capacity)) {
+            rebuild(a_reserve);
+        }
+    }
+
+    std::size_t compact_table::element_position(object const & a_key) noexcept {
+        if (a_key.is_integer()) {
+            auto const key = a_key.get_integer();
+            return key >= 0 ? static_cast<std::size_t>(key) : SIZE_MAX;
+        }
+
+        // Integral numbers address the same entries as integers.
+        if (a_key.is_number()) {
+            auto const key = a_key.get_number();
+
+            if (key >= 0.0 && key < maximum_element_number && std::trunc(key) == key) {
+                return static_cast<std::size_t>(key);
+            }
+        }
+
+        return SIZE_MAX;
+    }
+
+    void compact_table::append_element(object a_value) {
+        m_elements.push_back(std::move(a_value));
+        ++m_element_count;
+
+        // Keys following the array part may have been inserted into the hash
+        // part earlier; move them over while they are consecutive.
+        while (m_size != 0) {
+            object const key(static_cast<integer>(m_elements.size()));
+            auto value = erase_entry(key, key_hash(key));
+
+            if (value.is_null()) {
+                break;
+            }
+
+            m_elements.push_back(std::move(value));
+            ++m_element_count;
+        }
+    }
+
+    object compact_table::erase_entry(object const & a_key, std::size_t const a_hash) {
+        auto const slot = find_slot(a_key, a_hash);
+
+        if (slot == empty_slot) {
+            return {};
+        }
+
+        auto & entry = m_entries[slot_value(slot)];
+
+        set_slot_value(slot, removed_slot);
+        --m_size;
+
+        if (m_mode != table_mode::strong) {
+            release_weak(weak_component(entry), entry.hash);
+        }
+
+        // Leave a tombstone until the next rebuild.
+        entry.key = object();
+
+        return std::exchange(entry.value, object());
+    }
+
+    std::size_t compact_table::key_hash(object const & a_key) const {
+        if (m_mode == table_mode::weak_keys && weakly_holdable(a_key)) {
+            return hash_mix(a_key.m_data);
+        }
+
+        return a_key.hash();
+    }
+
+    bool compact_table::keys_equal(object const & a_entry_key, object const & a_key) const {
+        if (m_mode == table_mode::weak_keys && (weakly_holdable(a_entry_key) || weakly_holdable(a_key))) {
+            return a_entry_key.m_type == a_key.m_type && a_entry_key.m_data == a_key.m_data;
+        }
+
+        return a_entry_key.equals(a_key);
+    }
+
+    bool compact_table::weakly_holdable(object const & a_component) noexcept {
+        switch (a_component.object_type()) {
+            case type::function:
+            case type::table:
+            case type::array:
+            case type::native:
+                return !a_component.is_frozen();
+            default:
+                return false;
+        }
+    }
+
+    bool compact_table::held_only_here(object const & a_component) noexcept {
+        return weakly_holdable(a_component) && *std::bit_cast<std::size_t const *>(a_component.m_data) == 1;
+    }
+
+    void compact_table::hold_weakly(object const & a_component, std::size_t const a_hash) noexcept {
+        if (!weakly_holdable(a_component)) {
+            return;
+        }
+
+        register_weak_reference(std::bit_cast<void const *>(a_component.m_data), this, a_hash);
+
+        // Another reference exists, so this never destroys the payload.
+        --*std::bit_cast<std::size_t *>(a_component.m_data);
+    }
+
+    void compact_table::release_weak(object const & a_component, std::size_t const a_hash) noexcept {
+        if (!weakly_holdable(a_component)) {
+            return;
+        }
+
+        unregister_weak_reference(std::bit_cast<void const *>(a_component.m_data), this, a_hash);
+        ++*std::bit_cast<std::size_t *>(a_component.m_data);
+    }
+
+    void compact_table::remove_weak(void const * const a_referent, std::size_t const a_hash) noexcept {
+        auto const mask = m_index_capacity - 1;
+
+        for (auto slot = a_hash & mask;; slot = (slot + 1) & mask) {
+            auto const position = slot_value(slot);
+
+            if (position == empty_slot) {
+                return;
+            }
+
+            if (position == removed_slot) {
+                continue;
+            }
+
+            auto & entry = m_entries[position];
+            auto & component = weak_component(entry);
+
+            if (entry.hash != a_hash || !weakly_holdable(component) || std::bit_cast<void const *>(component.m_data) != a_referent) {
+                continue;
+            }
+
+            set_slot_value(slot, removed_slot);
+            --m_size;
+
+            // The payload is being destroyed, so forget it without releasing
+            // it, then release the other component of the entry last, as it
+            // may own this table.
+            component.m_type = type::null;
+            component.m_data = 0;
+
+            object const other = std::exchange(m_mode == table_mode::weak_keys ? entry.value : entry.key, object());
+            return;
+        }
+    }
+
+    std::size_t compact_table::slot_value(std::size_t const a_slot) const noexcept {
+        switch (m_index_width) {
+            case 1:
+                return widen_slot(static_cast<std::uint8_t const *>(m_index)[a_slot]);
+            case 2:
+                return widen_slot(static_cast<std::uint16_t const *>(m_index)[a_slot]);
+            default:
+                return widen_slot(static_cast<std::uint32_t const *>(m_index)[a_slot]);
+        }
+    }
+
+    void compact_table::set_slot_value(std::size_t const a_slot, std::size_t const a_value) noexcept {
+        // Truncating the markers leaves the all-ones patterns used by
+        // widen_slot().
+        switch (m_index_width) {
+            case 1:
+                static_cast<std::uint8_t *>(m_index)[a_slot] = static_cast<std::uint8_t>(a_value);
+                break;
+            case 2:
+                static_cast<std::uint16_t *>(m_index)[a_slot] = static_cast<std::uint16_t>(a_value);
+                break;
+            default:
+                static_cast<std::uint32_t *>(m_index)[a_slot] = static_cast<std::uint32_t>(a_value);
+                break;
+        }
+    }
+
+    std::size_t compact_table::find_slot(object const & a_key, std::size_t const a_hash) const {
+        auto const mask = m_index_capacity - 1;
+
+        // The index is never full, so probing always reaches an empty slot.
+        for (auto slot = a_hash & mask;; slot = (slot + 1) & mask) {
+            auto const position = slot_value(slot);
+
+            if (position == empty_slot) {
+                return empty_slot;
+            }
+
+            if (position != removed_slot) {
+                auto const & entry = m_entries[position];
+
+                if (entry.hash == a_hash && keys_equal(entry.key, a_key)) {
+                    return slot;
+                }
+            }
+        }
+    }
+
+    void compact_table::link(std::size_t const a_position) noexcept {
+        auto const mask = m_index_capacity - 1;
+
+        auto slot = m_entries[a_position].hash & mask;
+
+        while (slot_value(slot) != empty_slot) {
+            slot = (slot + 1) & mask;
+        }
+
+        set_slot_value(slot, a_position);
+    }
+
+    void compact_table::rebuild(std::size_t const a_capacity) {
+        auto index_capacity = minimum_index_capacity;
+
+        while (usable_capacity(index_capacity) < a_capacity) {
+            index_capacity *= 2;
+        }
+
+        // Slot values must leave room for the two markers.
+        std::size_t const index_width =
+            index_capacity <= 1ull << 8  ? 1 :
+            index_capacity <= 1ull << 16 ? 2 :
+            4;
+
+        // Allocate before modifying anything, so that a failure leaves the
+        // table intact.
+        m_entries.reserve(usable_capacity(index_capacity));
+
+        auto * const index = m_resource->allocate(index_capacity * index_width, index_width);
+
+        if (m_size != m_entries.size()) {
+            std::erase_if(m_entries, [](table_entry const & a_entry) {
+                return a_entry.key.is_null();
+            });
+        }
+
+        release_index();
+
+        m_index = index;
+        m_index_capacity = index_capacity;
+        m_index_width = index_width;
+
+        std::memset(m_index, 0xFF, m_index_capacity * m_index_width);
+
+        for (std::size_t i = 0; i < m_entries.size(); ++i) {
+            link(i);
+        }
+    }
+
+    void compact_table::release_index() noexcept {
+        if (m_index != nullptr) {
+            m_resource->deallocate(m_index, m_index_capacity * m_index_width, m_index_width);
+            m_index = nullptr;
+        }
+    }
+
+}
@@ -0,0 +1,269 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <rebar/lexical_analysis/character_scan.hpp>
+
+#include <bit>
+
+#include <rebar/lexical_analysis/character_class.hpp>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define REBAR_CHARACTER_SCAN_X86
+#include <immintrin.h>
+#endif
+
+namespace rebar {
+
+    namespace {
+
+        // Each character run is described by a class providing a scalar
+        // predicate and, on x86-64, vector predicates producing a byte mask
+        // of 0xFF for members.
+
+#ifdef REBAR_CHARACTER_SCAN_X86
+        /// Test bytes for membership of [v_low, v_high] with unsigned saturation.
+        template <char v_low, char v_high>
+        __m128i in_range_sse2(__m128i const a_bytes) noexcept {
+            auto const offset = _mm_sub_epi8(a_bytes, _mm_set1_epi8(v_low));
+            return _mm_cmpeq_epi8(_mm_subs_epu8(offset, _mm_set1_epi8(v_high - v_low)), _mm_setzero_si128());
+        }
+
+        template <char v_low, char v_high>
+        __attribute__((target("avx2")))
+        __m256i in_range_avx2(__m256i const a_bytes) noexcept {
+            auto const offset = _mm256_sub_epi8(a_bytes, _mm256_set1_epi8(v_low));
+            return _mm256_cmpeq_epi8(_mm256_subs_epu8(offset, _mm256_set1_epi8(v_high - v_low)), _mm256_setzero_si256());
+        }
+#endif
+
+        struct whitespace_run {
+            static bool scalar(unsigned char const a_char) noexcept {
+                return is_character_class(a_char, character_class::whitespace);
+            }
+
+#ifdef REBAR_CHARACTER_SCAN_X86
+            static __m128i sse2(__m128i const a_bytes) noexcept {
+                return _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(a_bytes, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(a_bytes, _mm_set1_epi8('\t'))),
+                    _mm_or_si128(_mm_cmpeq_epi8(a_bytes, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(a_bytes, _mm_set1_epi8('\r')))
+                );
+            }
+
+            __attribute__((target("avx2")))
+            static __m256i avx2(__m256i const a_bytes) noexcept {
+                return _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(a_bytes, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(a_bytes, _mm256_set1_epi8('\t'))),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(a_bytes, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(a_bytes, _mm256_set1_epi8('\r')))
+                );
+            }
+#endif
+        };
+
+        struct identifier_run {
+            static bool scalar(unsigned char const a_char) noexcept {
+                return is_character_class(a_char, character_class::identifier_continue);
+            }
+
+#ifdef REBAR_CHARACTER_SCAN_X86
+            // Setting bit 5 folds upper case letters onto lower case ones
+            // without moving any other character into [a, z].
+            static __m128i sse2(__m128i const a_bytes) noexcept {
+                return _mm_or_si128(
+                    _mm_or_si128(
+                        in_range_sse2<'a', 'z'>(_mm_or_si128(a_bytes, _mm_set1_epi8(0x20))),
+                        in_range_sse2<'0', '9'>(a_bytes)
+                    ),
+                    _mm_cmpeq_epi8(a_bytes, _mm_set1_epi8('_'))
+                );
+            }
+
+            __attribute__((target("avx2")))
+            static __m256i avx2(__m256i const a_bytes) noexcept {
+                return _mm256_or_si256(
+                    _mm256_or_si256(
+                        in_range_avx2<'a', 'z'>(_mm256_or_si256(a_bytes, _mm256_set1_epi8(0x20))),
+                        in_range_avx2<'0', '9'>(a_bytes)
+                    ),
+                    _mm256_cmpeq_epi8(a_bytes, _mm256_set1_epi8('_'))
+                );
+            }
+#endif
+        };
+
+        struct number_run {
+            static bool scalar(unsigned char const a_char) noexcept {
+                return is_character_class(a_char, character_class::digit) || a_char == '.' || a_char == '\'';
+            }
+
+#ifdef REBAR_CHARACTER_SCAN_X86
+            static __m128i sse2(__m128i const a_bytes) noexcept {
+                return _mm_or_si128(
+                    in_range_sse2<'0', '9'>(a_bytes),
+                    _mm_or_si128(_mm_cmpeq_epi8(a_bytes, _mm_set1_epi8('.')), _mm_cmpeq_epi8(a_bytes, _mm_set1_epi8('\'')))
+                );
+            }
+
+            __attribute__((target("avx2")))
+            static __m256i avx2(__m256i const a_bytes) noexcept {
+                return _mm256_or_si256(
+                    in_range_avx2<'0', '9'>(a_bytes),
+                    _mm256_or_si256(_mm256_cmpeq_epi8(a_bytes, _mm256_set1_epi8('.')), _mm256_cmpeq_epi8(a_bytes, _mm256_set1_epi8('\'')))
+                );
+            }
+#endif
+        };
+
+        struct string_run {
+            static bool scalar(unsigned char const a_char) noexcept {
+                return a_char != '"' && a_char != '\\';
+            }
+
+#ifdef REBAR_CHARACTER_SCAN_X86
+            static __m128i sse2(__m128i const a_bytes) noexcept {
+                auto const delimiters = _mm_or_si128(_mm_cmpeq_epi8(a_bytes, _mm_set1_epi8('"')), _mm_cmpeq_epi8(a_bytes, _mm_set1_epi8('\\')));
+                return _mm_andnot_si128(delimiters, _mm_set1_epi8(-1));
+            }
+
+            __attribute__((target("avx2")))
+            static __m256i avx2(__m256i const a_bytes) noexcept {
+                auto const delimiters = _mm256_or_si256(_mm256_cmpeq_epi8(a_bytes, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(a_bytes, _mm256_set1_epi8('\\')));
+                return _mm256_andnot_si256(delimiters, _mm256_set1_epi8(-1));
+            }
+#endif
+        };
+
+        struct line_run {
+            static bool scalar(unsigned char const a_char) noexcept {
+                return a_char != '\n';
+            }
+
+#ifdef REBAR_CHARACTER_SCAN_X86
+            static __m128i sse2(__m128i const a_bytes) noexcept {
+                return _mm_andnot_si128(_mm_cmpeq_epi8(a_bytes, _mm_set1_epi8('\n')), _mm_set1_epi8(-1));
+            }
+
+            __attribute__((target("avx2")))
+            static __m256i avx2(__m256i const a_bytes) noexcept {
+                return _mm256_andnot_si256(_mm256_cmpeq_epi8(a_bytes, _mm256_set1_epi8('\n')), _mm256_set1_epi8(-1));
+            }
+#endif
+        };
+
+        template <typename t_run>
+        char const * scan_scalar(char const * a_begin, char const * const a_end) noexcept {
+            while (a_begin != a_end && t_run::scalar(static_cast<unsigned char>(*a_begin))) {
+                ++a_begin;
+            }
+
+            return a_begin;
+        }
+
+#ifdef REBAR_CHARACTER_SCAN_X86
+        template <typename t_run>
+        char const * scan_sse2(char const * a_begin, char const * const a_end) noexcept {
+            // Most runs are short, so test the first character before
+            // paying for a vector load.
+            if (a_begin == a_end || !t_run::scalar(static_cast<unsigned char>(*a_begin))) {
+                return a_begin;
+            }
+
+            while (a_end - a_begin >= 16) {
+                auto const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a_begin));
+                auto const members = static_cast<std::uint32_t>(_mm_movemask_epi8(t_run::sse2(bytes)));
+
+                if (members != 0xFFFF) {
+                    return a_begin + std::countr_one(members);
+                }
+
+                a_begin += 16;
+            }
+
+            return scan_scalar<t_run>(a_begin, a_end);
+        }
+
+        template <typename t_run>
+        __attribute__((target("avx2")))
+        char const * scan_avx2(char const * a_begin, char const * const a_end) noexcept {
+            if (a_begin == a_end || !t_run::scalar(static_cast<unsigned char>(*a_begin))) {
+                return a_begin;
+            }
+
+            while (a_end - a_begin >= 32) {
+                auto const bytes = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a_begin));
+                auto const members = static_cast<std::uint32_t>(_mm256_movemask_epi8(t_run::avx2(bytes)));
+
+                if (members != 0xFFFFFFFF) {
+                    return a_begin + std::countr_one(members);
+                }
+
+                a_begin += 32;
+            }
+
+            return scan_scalar<t_run>(a_begin, a_end);
+        }
+#endif
+
+        constexpr character_scanner scalar_scanner{
+            scan_isa::scalar,
+            scan_scalar<whitespace_run>,
+            scan_scalar<identifier_run>,
+            scan_scalar<number_run>,
+            scan_scalar<string_run>,
+            scan_scalar<line_run>,
+        };
+
+#ifdef REBAR_CHARACTER_SCAN_X86
+        constexpr character_scanner sse2_scanner{
+            scan_isa::sse2,
+            scan_sse2<whitespace_run>,
+            scan_sse2<identifier_run>,
+            scan_sse2<number_run>,
+            scan_sse2<string_run>,
+            scan_sse2<line_run>,
+        };
+
+        constexpr character_scanner avx2_scanner{
+            scan_isa::avx2,
+            scan_avx2<whitespace_run>,
+            scan_avx2<identifier_run>,
+            scan_avx2<number_run>,
+            scan_avx2<string_run>,
+            scan_avx2<line_run>,
+        };
+#endif
+
+    }
+
+    character_scanner const & default_character_scanner() noexcept {
+        static character_scanner const * const scanner = [] {
+            if (auto const avx2 = character_scanner_for(scan_isa::avx2); avx2 != nullptr) {
+                return avx2;
+            }
+
+            if (auto const sse2 = character_scanner_for(scan_isa::sse2); sse2 != nullptr) {
+                return sse2;
+            }
+
+            return &scalar_scanner;
+        }();
+
+        return *scanner;
+    }
+
+    character_scanner const * character_scanner_for(scan_isa const a_isa) noexcept {
+        switch (a_isa) {
+            case scan_isa::scalar:
+                return &scalar_scanner;
+#ifdef REBAR_CHARACTER_SCAN_X86
+            case scan_isa::sse2:
+                return &sse2_scanner;
+            case scan_isa::avx2:
+                return __builtin_cpu_supports("avx2") ? &avx2_scanner : nullptr;
+#endif
+            default:
+                return nullptr;
+        }
+    }
+
+}
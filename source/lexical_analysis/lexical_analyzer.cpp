@@ -4,267 +4,685 @@
 
 #include <rebar/lexical_analysis/lexical_analyzer.hpp>
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <rebar/lexical_analysis/character_class.hpp>
+#include <rebar/lexical_analysis/character_scan.hpp>
+#include <rebar/lexical_analysis/token_ring.hpp>
+
 namespace rebar {
 
+    namespace {
+
+        /**
+         * Parse a numeric literal with std::from_chars, independent of the
+         * current locale. Separators are filtered into a stack buffer, so
+         * only unusually long literals allocate.
+         */
+        template <typename t_value>
+        t_value parse_numeric_literal(std::string_view const a_raw_string, bool const a_has_separators) {
+            std::array<char, 128> buffer;
+            std::string long_buffer;
+
+            std::string_view digits = a_raw_string;
+
+            // Filter out separators if present.
+            if (a_has_separators && a_raw_string.find('\'') != std::string_view::npos) {
+                char * destination = buffer.data();
+
+                if (a_raw_string.size() > buffer.size()) [[unlikely]] {
+                    long_buffer.resize(a_raw_string.size());
+                    destination = long_buffer.data();
+                }
+
+                auto const destination_end = std::remove_copy(a_raw_string.cbegin(), a_raw_string.cend(), destination, '\'');
+                digits = std::string_view(destination, destination_end);
+            }
+
+            t_value value{};
+
+            // Like the std::sto* functions, parse the longest valid prefix.
+            if (auto const [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), value); error != std::errc()) [[unlikely]] {
+                if (error == std::errc::result_out_of_range) {
+                    throw std::out_of_range(fmt::format("Numeric literal '{}' is out of range.", a_raw_string));
+                }
+
+                throw std::invalid_argument(fmt::format("Invalid numeric literal '{}'.", a_raw_string));
+            }
+
+            return value;
+        }
+
+        /// Chunks of the plaintext smaller than this are not worth a thread.
+        constexpr std::size_t minimum_parallel_chunk_size = 256 * 1024;
+
+        /**
+         * Speculate whether a chunk of a plaintext begins inside a string
+         * literal, by the first unescaped quotation mark in the chunk: one
+         * closing a literal is typically followed by punctuation ending an
+         * expression, while one opening a literal is not.
+         * @return The offset into the chunk at which to begin analysis; past
+         *         the closing quotation mark if the chunk is thought to begin
+         *         inside a string literal, otherwise zero.
+         */
+        std::size_t speculate_chunk_start(std::string_view const a_chunk, character_scanner const & a_scanner) noexcept {
+            auto const chunk_begin = a_chunk.data();
+            auto const chunk_end = a_chunk.data() + a_chunk.size();
+
+            auto quote = a_scanner.skip_string(chunk_begin, chunk_end);
+
+            while (quote != chunk_end && *quote == '\\') {
+                quote = a_scanner.skip_string(std::min(quote + 2, chunk_end), chunk_end);
+            }
+
+            if (quote == chunk_end || quote + 1 == chunk_end) {
+                return 0;
+            }
+
+            return std::string_view(";,)]}\r\n").find(quote[1]) != std::string_view::npos ? quote + 1 - chunk_begin : 0;
+        }
+
+        /**
+         * Tokens speculatively analyzed from a chunk of a plaintext. The
+         * payloads of identifier and string tokens hold the index of their
+         * string in the chunk's distinct strings (as integer_value), so that
+         * each distinct string is interned only once when joined.
+         */
+        struct speculative_chunk {
+            std::size_t                begin        = 0; ///< Position at which speculative analysis began.
+            std::size_t                end          = 0;
+            std::size_t                analyzed_end = 0; ///< Position at which speculative analysis stopped.
+            std::vector<token_type>    types        = {};
+            std::vector<token_payload> payloads     = {};
+            std::vector<std::uint32_t> positions    = {};
+            std::vector<string>        strings      = {};
+        };
+
+    }
+
     void lexical_analyzer::perform_analysis(lexical_unit & a_lexical_unit) const {
+        lexical_unit::check_plaintext_size(a_lexical_unit.plaintext().size());
+
+        // Reserve the token stream for a typical density of one token per
+        // six bytes of plaintext, avoiding most reallocation.
+        a_lexical_unit.reserve_tokens(a_lexical_unit.plaintext().size() / 6);
+
+        analyze_plaintext(a_lexical_unit.plaintext(), true, [&a_lexical_unit](token && a_token, std::size_t const a_position) {
+            a_lexical_unit.push_token(std::move(a_token), a_position);
+            return true;
+        });
+    }
+
+    void lexical_analyzer::perform_parallel_analysis(lexical_unit & a_lexical_unit, std::size_t a_thread_count) const {
         std::string_view const plaintext = a_lexical_unit.plaintext();
-        auto plaintext_it = plaintext.cbegin();
-
-        // Keeps incrementing the plaintext iterator until the predicate
-        // function returns true. Returns final iterator.
-        auto const plaintext_increment_find =
-            [&plaintext_it, &plaintext]<typename t_predicate>(t_predicate const predicate) noexcept
-            requires(std::predicate<t_predicate, char const>)
-            {
-                while (++plaintext_it != plaintext.cend()) {
-                    if (predicate(*plaintext_it)) {
-                        return plaintext_it;
+
+        lexical_unit::check_plaintext_size(plaintext.size());
+
+        if (a_thread_count == 0) {
+            a_thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        auto const chunk_count = std::min(a_thread_count, plaintext.size() / minimum_parallel_chunk_size);
+
+        if (chunk_count <= 1) {
+            perform_analysis(a_lexical_unit);
+            return;
+        }
+
+        // Each chunk is analyzed with its own string engine, as engines are
+        // not thread-safe. Its strings are interned into the analyzer's
+        // engine when joined. (The engines must outlive the chunks' tokens.)
+        std::vector<string_engine> chunk_string_engines(chunk_count);
+
+        // Split the plaintext into chunks beginning at line boundaries, where
+        // a token (string literals included) is least likely to continue.
+        std::vector<speculative_chunk> chunks;
+        chunks.reserve(chunk_count);
+
+        for (std::size_t i = 0; i < chunk_count; ++i) {
+            auto begin = plaintext.size() / chunk_count * i;
+
+            if (i != 0) {
+                auto const line_end = plaintext.find('\n', begin);
+                begin = line_end == std::string_view::npos ? plaintext.size() : line_end + 1;
+            }
+
+            if (!chunks.empty() && (begin <= chunks.back().begin || begin == plaintext.size())) {
+                continue;
+            }
+
+            if (!chunks.empty()) {
+                chunks.back().end = begin;
+            }
+
+            chunks.push_back({ begin, plaintext.size() });
+        }
+
+        auto const analyze_chunk = [this, plaintext, &chunks, &chunk_string_engines](std::size_t const a_index) noexcept {
+            auto & chunk = chunks[a_index];
+
+            lexical_analyzer chunk_analyzer(*this);
+            chunk_analyzer.m_string_engine = &chunk_string_engines[a_index];
+
+            if (a_index != 0) {
+                chunk.begin += speculate_chunk_start(plaintext.substr(chunk.begin, chunk.end - chunk.begin), default_character_scanner());
+            }
+
+            std::unordered_map<string_reference, std::size_t> string_indices;
+
+            try {
+                chunk.analyzed_end = chunk.begin + chunk_analyzer.analyze_plaintext(
+                    plaintext.substr(chunk.begin, chunk.end - chunk.begin),
+                    chunk.end == plaintext.size(),
+                    [&chunk, &string_indices](token && a_token, std::size_t const a_offset) {
+                        auto payload = a_token.payload();
+
+                        if (a_token.is_identifier() || a_token.is_string()) {
+                            auto const [it, inserted] = string_indices.try_emplace(payload.string_value, chunk.strings.size());
+
+                            if (inserted) {
+                                chunk.strings.push_back(a_token.get_string());
+                            }
+
+                            payload.integer_value = static_cast<integer>(it->second);
+                        }
+
+                        chunk.types.push_back(a_token.type());
+                        chunk.payloads.push_back(payload);
+                        chunk.positions.push_back(static_cast<std::uint32_t>(chunk.begin + a_offset));
+                        return true;
+                    }
+                );
+            } catch (...) {
+                // A misspeculated chunk may contain invalid literals that are
+                // really the contents of a string literal. Keep the tokens
+                // before the last one (which ends where analysis resumes) and
+                // leave the rest to sequential analysis, which raises any
+                // genuine error.
+                chunk.analyzed_end = chunk.positions.empty() ? chunk.begin : chunk.positions.back();
+
+                if (!chunk.positions.empty()) {
+                    chunk.types.pop_back();
+                    chunk.payloads.pop_back();
+                    chunk.positions.pop_back();
+                }
+            }
+        };
+
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(chunks.size() - 1);
+
+            for (std::size_t i = 1; i < chunks.size(); ++i) {
+                workers.emplace_back(analyze_chunk, i);
+            }
+
+            analyze_chunk(0);
+        }
+
+        std::size_t speculative_token_count = 0;
+
+        for (auto const & chunk : chunks) {
+            speculative_token_count += chunk.types.size();
+        }
+
+        a_lexical_unit.reserve_tokens(speculative_token_count);
+
+        // Append the speculative tokens of a chunk from an index onwards,
+        // interning each of its distinct strings once.
+        auto const join_chunk = [this, &a_lexical_unit](speculative_chunk & a_chunk, std::size_t const a_first_token) {
+            std::vector<string> strings;
+            strings.reserve(a_chunk.strings.size());
+
+            for (auto const & chunk_string : a_chunk.strings) {
+                strings.push_back(m_string_engine->str(chunk_string.view()));
+            }
+
+            for (auto i = a_first_token; i < a_chunk.types.size(); ++i) {
+                if (a_chunk.types[i] == token_type::identifier || a_chunk.types[i] == token_type::string) {
+                    a_chunk.payloads[i].string_value = strings[a_chunk.payloads[i].integer_value].reference();
+                }
+            }
+
+            a_lexical_unit.append_tokens(
+                std::span(a_chunk.types).subspan(a_first_token),
+                std::span(a_chunk.payloads).subspan(a_first_token),
+                std::span(a_chunk.positions).subspan(a_first_token),
+                strings
+            );
+        };
+
+        std::size_t position = 0;
+        std::size_t next_chunk = 0;
+
+        while (position != plaintext.size()) {
+            if (next_chunk != chunks.size() && position == chunks[next_chunk].begin) {
+                join_chunk(chunks[next_chunk], 0);
+                position = chunks[next_chunk].analyzed_end;
+                ++next_chunk;
+                continue;
+            }
+
+            // Resynchronize: analyze sequentially until a token begins at the
+            // same position as a speculative token, after which the
+            // analyses are identical.
+            std::size_t synchronized_chunk = chunks.size();
+            std::size_t synchronized_token = 0;
+
+            analyze_plaintext(
+                plaintext.substr(position),
+                true,
+                [&](token && a_token, std::size_t const a_offset) {
+                    auto const token_position = position + a_offset;
+
+                    auto const chunk = std::ranges::upper_bound(
+                        chunks.begin() + static_cast<std::ptrdiff_t>(next_chunk),
+                        chunks.end(),
+                        token_position,
+                        std::ranges::less{},
+                        &speculative_chunk::begin
+                    );
+
+                    if (chunk != chunks.begin() + static_cast<std::ptrdiff_t>(next_chunk)) {
+                        auto const & candidate = *(chunk - 1);
+
+                        if (auto const match = std::ranges::lower_bound(candidate.positions, token_position); match != candidate.positions.end() && *match == token_position) {
+                            synchronized_chunk = static_cast<std::size_t>(chunk - 1 - chunks.begin());
+                            synchronized_token = static_cast<std::size_t>(match - candidate.positions.begin());
+                            return false;
+                        }
+                    }
+
+                    a_lexical_unit.push_token(std::move(a_token), token_position);
+                    return true;
+                }
+            );
+
+            if (synchronized_chunk == chunks.size()) {
+                break;
+            }
+
+            join_chunk(chunks[synchronized_chunk], synchronized_token);
+            position = chunks[synchronized_chunk].analyzed_end;
+            next_chunk = synchronized_chunk + 1;
+        }
+    }
+
+    void lexical_analyzer::perform_incremental_analysis(
+        lexical_unit & a_lexical_unit,
+        std::size_t const a_offset,
+        std::size_t const a_removed_length,
+        std::string_view const a_inserted_text
+    ) const {
+        std::string_view const plaintext = a_lexical_unit.plaintext();
+
+        if (a_offset > plaintext.size() || a_removed_length > plaintext.size() - a_offset) {
+            throw std::out_of_range(fmt::format(
+                "Edit removing {} characters at position {} exceeds the plaintext ({} characters).",
+                a_removed_length,
+                a_offset,
+                plaintext.size()
+            ));
+        }
+
+        lexical_unit::check_plaintext_size(plaintext.size() - a_removed_length + a_inserted_text.size());
+
+        auto const edited_plaintext = std::make_shared<std::string>();
+        edited_plaintext->reserve(plaintext.size() - a_removed_length + a_inserted_text.size());
+        edited_plaintext->append(plaintext.substr(0, a_offset));
+        edited_plaintext->append(a_inserted_text);
+        edited_plaintext->append(plaintext.substr(a_offset + a_removed_length));
+
+        auto const position_shift = static_cast<std::int64_t>(a_inserted_text.size()) - static_cast<std::int64_t>(a_removed_length);
+        auto const edit_end = a_offset + a_inserted_text.size();
+
+        // Resume at the last token beginning far enough before the edit that
+        // neither it nor its predecessors looked ahead into it. (No token
+        // looks further ahead than the longest symbol, or one character.)
+        auto const positions = a_lexical_unit.token_positions();
+        auto const lookahead = std::max<std::size_t>(m_symbol_trie.max_length(), 1);
+
+        // Without such a token, the edit may precede every token (or lie in
+        // leading whitespace), so analysis resumes at the beginning.
+        std::size_t first_token = 0;
+        std::size_t resume_position = 0;
+
+        if (a_offset > lookahead) {
+            auto const unaffected_end = std::ranges::upper_bound(positions, a_offset - lookahead - 1);
+
+            if (unaffected_end != positions.begin()) {
+                first_token = static_cast<std::size_t>(unaffected_end - positions.begin()) - 1;
+                resume_position = positions[first_token];
+            }
+        }
+
+        // Analyze the edited region into a unit holding the edited plaintext.
+        auto edited = lexical_unit::load(*edited_plaintext, edited_plaintext);
+        std::size_t last_token = positions.size();
+
+        analyze_plaintext(
+            edited.plaintext().substr(resume_position),
+            true,
+            [&](token && a_token, std::size_t const a_token_offset) {
+                auto const token_position = resume_position + a_token_offset;
+
+                // Past the edit, a token beginning where one previously did
+                // (before shifting) is followed by the same tokens as before.
+                if (token_position >= edit_end) {
+                    auto const previous_position = static_cast<std::uint32_t>(static_cast<std::int64_t>(token_position) - position_shift);
+                    auto const previous = std::ranges::lower_bound(positions.subspan(first_token), previous_position);
+
+                    if (previous != positions.end() && *previous == previous_position) {
+                        last_token = static_cast<std::size_t>(previous - positions.begin());
+                        return false;
                     }
                 }
 
-                return plaintext.cend();
+                edited.push_token(std::move(a_token), token_position);
+                return true;
+            }
+        );
+
+        a_lexical_unit.splice(edited, first_token, last_token, position_shift);
+    }
+
+    std::size_t lexical_analyzer::perform_partial_analysis(
+        std::string_view const a_plaintext,
+        std::size_t const a_position,
+        bool const a_final,
+        token_ring & a_tokens
+    ) const {
+        if (a_tokens.full()) {
+            return 0;
+        }
+
+        return analyze_plaintext(a_plaintext, a_final, [a_position, &a_tokens](token && a_token, std::size_t const a_offset) {
+            a_tokens.push(std::move(a_token), a_position + a_offset);
+            return !a_tokens.full();
+        });
+    }
+
+    template <typename t_sink>
+    std::size_t lexical_analyzer::analyze_plaintext(std::string_view const a_plaintext, bool const a_final, t_sink && a_sink) const {
+        auto plaintext_it = a_plaintext.cbegin();
+
+        // Whether a token beginning at the current position may continue
+        // past the end of the plaintext (only if more input follows).
+        auto const reaches_end = [&a_plaintext, a_final](auto const a_token_end) noexcept {
+            return !a_final && a_token_end == a_plaintext.cend();
+        };
+
+        // Advances the plaintext iterator past the run of characters
+        // following it that the scan function accepts (using the fastest
+        // vectorized scanner available). Returns final iterator.
+        auto const plaintext_scan_past =
+            [&plaintext_it, &a_plaintext](character_scanner::scan_function const a_scan) noexcept {
+                auto const position = std::to_address(plaintext_it);
+                auto const run_end = a_scan(position + 1, a_plaintext.data() + a_plaintext.size());
+
+                plaintext_it += run_end - position;
+
+                return plaintext_it;
             };
 
+        character_scanner const & scanner = default_character_scanner();
+
+        // Offsets of escape sequences in the string literal being analyzed.
+        // (Kept outside the loop to reuse its allocation.)
+        std::vector<std::size_t> escape_offsets;
+
         // Find the index into the plaintext to which the specified iterator
         // corresponds.
-        auto const get_iterator_plaintext_index = [&plaintext](auto const iterator) noexcept -> std::size_t {
-            return std::distance(plaintext.cbegin(), iterator);
+        auto const get_iterator_plaintext_index = [&a_plaintext](auto const iterator) noexcept -> std::size_t {
+            return std::distance(a_plaintext.cbegin(), iterator);
         };
 
         // Main analysis loop.
-        while (plaintext_it != plaintext.cend()) {
+        while (plaintext_it != a_plaintext.cend()) {
             unsigned char const current_char = *plaintext_it;
-            unsigned char const next_char = (plaintext_it + 1 != plaintext.cend()) ? *(plaintext_it + 1) : '\0';
+            unsigned char const next_char = (plaintext_it + 1 != a_plaintext.cend()) ? *(plaintext_it + 1) : '\0';
 
             // Skip spaces, tabs, and other whitespace/non-display characters.
-            if (current_char == ' ' || current_char == '\t' || current_char == '\n' || current_char == '\r') {
-                ++plaintext_it;
+            if (is_character_class(current_char, character_class::whitespace)) {
+                plaintext_scan_past(scanner.skip_whitespace);
                 continue;
             }
 
             // Test for conditions of a string.
             if (current_char == '"') {
                 auto const string_begin = plaintext_it;
+                auto const content_begin = std::to_address(string_begin) + 1;
+                auto const plaintext_end = a_plaintext.data() + a_plaintext.size();
 
-                // Whether the parsed string contains an escape sequence or
-                // not.
-                bool contains_escape_sequence = false;
+                // Find end of string, recording the offset of each escape
+                // sequence on the way so that they never need to be searched
+                // for again.
+                escape_offsets.clear();
 
-                // Find end of string.
-                auto const string_end = plaintext_increment_find(
-                    [&plaintext_it, &contains_escape_sequence](auto const position_char) noexcept {
-                        // End string parsing with ending quotation marks.
-                        if (position_char == '\"') [[unlikely]] {
-                            return true;
-                        }
+                auto content_end = scanner.skip_string(content_begin, plaintext_end);
 
-                        // Skip past escape sequence.
-                        if (position_char == '\\') [[unlikely]] {
-                            // TODO: Optimize escape sequence handling by storing relative escape sequence locations and forwarding to process_string.
-                            // (The array of locations can also replace the explicit boolean flag. - !locations.empty())
-                            // (Make explicit positions optional, retaining the ability to scan for them.)
+                while (content_end != plaintext_end && *content_end == '\\') [[unlikely]] {
+                    escape_offsets.push_back(content_end - content_begin);
 
-                            contains_escape_sequence = true;
-                            ++plaintext_it;
-                        }
+                    // Skip past the backslash and the character it escapes.
+                    content_end = scanner.skip_string(std::min(content_end + 2, plaintext_end), plaintext_end);
+                }
 
-                        return false;
-                    }
-                );
+                // An unterminated string may be terminated by further input.
+                if (!a_final && content_end == plaintext_end) {
+                    break;
+                }
 
-                // Advance iterator past sentinel/ending quotation marks.
-                ++plaintext_it;
+                // Advance iterator past ending quotation marks (if the string
+                // is terminated).
+                plaintext_it += content_end - std::to_address(string_begin) + (content_end != plaintext_end);
 
-                // Add 1 to string_begin to avoid capturing quotation marks.
-                auto const raw_string = std::string_view(string_begin + 1, string_end);
+                auto const raw_string = std::string_view(content_begin, content_end);
                 // Replace escape sequences if present.
                 auto const final_string = m_string_engine->str(
-                    contains_escape_sequence ?
-                    process_string(raw_string) :
-                    raw_string
+                    escape_offsets.empty() ?
+                    raw_string :
+                    process_string(raw_string, escape_offsets)
                 );
                 auto const plaintext_position = get_iterator_plaintext_index(string_begin);
 
                 // Add token to analysis result.
-                a_lexical_unit.push_token(
-                    token(final_string, token_type::string),
-                    plaintext_position
-                );
+                if (!a_sink(token(final_string, token_type::string), plaintext_position)) {
+                    break;
+                }
 
                 continue;
             }
             // End string parsing.
 
             // Test for conditions of integer/number.
+            // (A sign or decimal point ending the plaintext may begin a
+            // number continued by further input.)
             if (
-                std::isdigit(current_char) ||
-                (current_char == '-' && (std::isdigit(next_char) || next_char == '.') ||
-                (current_char == '.' && std::isdigit(next_char)))
+                (current_char == '-' || current_char == '.') && reaches_end(plaintext_it + 1)
             ) {
-                auto const number_begin = plaintext_it;
-
-                // Store if parsed number has a decimal (number, floating
-                // point).
-                bool floating_point = current_char == '.'; // Test leading decimal.
+                break;
+            }
 
-                // Store if separating apostrophes are used.
-                bool separating_characters = false;
+            if (
+                is_character_class(current_char, character_class::digit) ||
+                (current_char == '-' && (is_character_class(next_char, character_class::digit) || next_char == '.')) ||
+                (current_char == '.' && is_character_class(next_char, character_class::digit))
+            ) {
+                auto const number_begin = plaintext_it;
 
                 // Find end of number string.
-                auto const number_end = plaintext_increment_find(
-                    [&floating_point, &separating_characters](unsigned char const position_char) {
-                        if (position_char == '.') [[unlikely]] {
-                            floating_point = true;
-                            return false;
-                        }
+                auto const number_end = plaintext_scan_past(scanner.skip_number);
 
-                        if (position_char == '\'') [[unlikely]] {
-                            separating_characters = true;
-                            return false;
-                        }
-
-                        return !std::isdigit(position_char) && position_char != '\'';
-                    }
-                );
+                if (reaches_end(number_end)) {
+                    plaintext_it = number_begin;
+                    break;
+                }
 
                 std::string_view const raw_number_string(number_begin, number_end);
                 auto const plaintext_position = get_iterator_plaintext_index(number_begin);
 
-                if (floating_point) {
-                    a_lexical_unit.push_token(
-                        token(parse_number(raw_number_string)),
-                        plaintext_position
-                    );
-                } else {
-                    a_lexical_unit.push_token(
-                        token(parse_integer(raw_number_string)),
-                        plaintext_position
-                    );
+                // Store if parsed number has a decimal (number, floating
+                // point) and if separating apostrophes are used.
+                bool const floating_point = raw_number_string.find('.') != std::string_view::npos;
+                bool const separating_characters = raw_number_string.find('\'') != std::string_view::npos;
+
+                auto number_token = floating_point ?
+                    token(parse_number(raw_number_string, separating_characters)) :
+                    token(parse_integer(raw_number_string, separating_characters));
+
+                if (!a_sink(std::move(number_token), plaintext_position)) {
+                    break;
                 }
 
                 continue;
             }
             // End integer/number parsing.
 
-            // Test for different symbols.
-            std::pair<symbol, bool> const * symbol_pair = nullptr;
-            auto symbol_end = plaintext_it + 1;
-
-            // TODO: Optimize symbol searching with search trees.
-
-            // Search for longest symbol match.
-            for (
-                std::size_t length = 0;
-                length <= std::min(
-                    m_max_symbol_length,
-                    static_cast<std::size_t>(std::distance(plaintext_it, plaintext.cend()))
-                );
-                ++length
-            ) {
-                auto const current_end_it = plaintext_it + static_cast<std::int64_t>(length);
-
-                if (auto const symbol_it = m_symbol_map.find(std::string_view(plaintext_it, current_end_it)); symbol_it != m_symbol_map.cend()) {
-                    symbol_pair = &(symbol_it->second);
-                    symbol_end = current_end_it;
+            // Test for different symbols, if any begins with the character.
+            // (Symbols of runtime symbol maps may begin with any character.)
+            if (m_symbol_trie.starts_symbol(current_char)) {
+                // Without at least one character beyond the longest symbol,
+                // neither the longest match nor whether a keyword is
+                // interrupting an identifier can be known.
+                if (!a_final && static_cast<std::size_t>(a_plaintext.cend() - plaintext_it) <= m_symbol_trie.max_length()) {
+                    break;
                 }
-            }
 
-            // Test that symbol has been found.
-            if (symbol_pair != nullptr) {
-                // Test that symbol is not interrupting an identifier.
+                auto const match = m_symbol_trie.longest_match(std::string_view(plaintext_it, a_plaintext.cend()));
+                auto const symbol_end = plaintext_it + static_cast<std::int64_t>(match.length);
+
+                // Test that symbol has been found and is not interrupting an
+                // identifier.
                 if (
-                    auto const following_char = symbol_end != plaintext.cend() ? *symbol_end : '\0';
-                    !symbol_pair->second || !(std::isalnum(following_char) || following_char == '_')
+                    match.length != 0 &&
+                    (!match.keyword || symbol_end == a_plaintext.cend() || !is_character_class(*symbol_end, character_class::identifier_continue))
                 ) {
                     auto const plaintext_position = get_iterator_plaintext_index(plaintext_it);
 
-                    a_lexical_unit.push_token(
-                        token(symbol_pair->first),
-                        plaintext_position
-                    );
-
                     // Set next scanning position.
                     plaintext_it = symbol_end;
 
+                    if (!a_sink(token(match.value), plaintext_position)) {
+                        break;
+                    }
+
                     continue;
                 }
             }
             // End symbol testing.
 
             // Test for conditions of an identifier token.
-            if (std::isalpha(current_char) || current_char == '_') {
+            if (is_character_class(current_char, character_class::identifier_start)) {
                 auto const identifier_begin = plaintext_it;
 
                 // Find end of identifier.
-                auto const identifier_end = plaintext_increment_find(
-                    [](unsigned char const position_char) noexcept {
-                        return !std::isalnum(position_char) && position_char != '_';
-                    }
-                );
+                auto const identifier_end = plaintext_scan_past(scanner.skip_identifier);
+
+                if (reaches_end(identifier_end)) {
+                    plaintext_it = identifier_begin;
+                    break;
+                }
 
                 // Compile identifier and its plaintext position.
                 auto const identifier = m_string_engine->str(std::string_view(identifier_begin, identifier_end));
                 auto const plaintext_position = get_iterator_plaintext_index(identifier_begin);
 
                 // Add token to analysis result.
-                a_lexical_unit.push_token(
-                    token(identifier, token_type::identifier),
-                    plaintext_position
-                );
+                if (!a_sink(token(identifier, token_type::identifier), plaintext_position)) {
+                    break;
+                }
 
                 continue;
             }
             // End identifier parsing.
+
+            // No token begins with the character. (Continuing would never
+            // advance past it.)
+            throw std::invalid_argument(fmt::format(
+                "Unexpected character 0x{:02X} at position {}.",
+                current_char,
+                get_iterator_plaintext_index(plaintext_it)
+            ));
         }
+
+        return get_iterator_plaintext_index(plaintext_it);
     }
 
     std::string lexical_analyzer::process_string(std::string_view const a_raw_string) const {
+        character_scanner const & scanner = default_character_scanner();
+
+        auto const string_begin = a_raw_string.data();
+        auto const string_end = a_raw_string.data() + a_raw_string.size();
+
+        // Find escape sequences.
+        std::vector<std::size_t> escape_offsets;
+
+        for (
+            auto position = scanner.skip_string(string_begin, string_end);
+            position != string_end;
+            position = scanner.skip_string(position, string_end)
+        ) {
+            if (*position == '\\') {
+                escape_offsets.push_back(position - string_begin);
+                position = std::min(position + 2, string_end);
+            } else {
+                ++position;
+            }
+        }
+
+        return process_string(a_raw_string, escape_offsets);
+    }
+
+    std::string lexical_analyzer::process_string(std::string_view const a_raw_string, std::span<std::size_t const> const a_escape_offsets) const {
         std::string final_string;
 
         // Reserve as much space as original string to avoid reallocation.
         // New string is unlikely to exceed this amount.
         final_string.reserve(a_raw_string.size());
 
-        auto string_it = a_raw_string.begin();
-
         // Store beginning of string part to add to final string between
         // escape sequences.
-        auto string_part_begin = string_it;
-
-        while (string_it != a_raw_string.cend() && string_it + 1 != a_raw_string.cend()) {
-            auto const current_char = *string_it;
-
-            // Test for escape sequence.
-            if (current_char == '\\') {
-                // Add preceding string part to the final string.
-                final_string += std::string_view(string_part_begin, string_it);
-
-                // Advance iterator and read leading escape sequence character.
-                auto const lead_character = *(++string_it);
+        std::size_t part_begin = 0;
 
-                // TODO: Add proper escape sequence error handling on invalid sequences.
-                auto const handler = m_escape_sequence_map.at(lead_character);
+        for (auto const escape_offset : a_escape_offsets) {
+            // Skip backslashes consumed by the preceding escape sequence.
+            if (escape_offset < part_begin) [[unlikely]] {
+                continue;
+            }
 
-                // Get replacement and sequence length by passing entire rest
-                // of the string following the backslash.
-                auto [replacement, sequence_length] = handler(std::string_view(string_it, a_raw_string.cend()));
+            // A trailing backslash escapes nothing; keep it as is.
+            if (escape_offset + 1 == a_raw_string.size()) [[unlikely]] {
+                break;
+            }
 
-                final_string += replacement;
+            // Add preceding string part to the final string.
+            final_string += a_raw_string.substr(part_begin, escape_offset - part_begin);
 
-                // Advance iterator past escape sequence.
-                string_it += static_cast<int64_t>(sequence_length);
+            // TODO: Add proper escape sequence error handling on invalid sequences.
+            auto const handler = m_escape_sequence_map.at(a_raw_string[escape_offset + 1]);
 
-                // Set new string part beginning iterator.
-                string_part_begin = string_it;
+            // Get replacement and sequence length by passing entire rest
+            // of the string following the backslash.
+            auto [replacement, sequence_length] = handler(a_raw_string.substr(escape_offset + 1));
 
-                continue;
-            }
+            final_string += replacement;
 
-            ++string_it;
+            // Set new string part beginning past the escape sequence.
+            part_begin = escape_offset + 1 + sequence_length;
         }
 
         // Add trailing string part to final string.
-        final_string += std::string_view(string_part_begin, string_it + 1);
+        final_string += a_raw_string.substr(std::min(part_begin, a_raw_string.size()));
 
         // False positive: address escape.
         // ReSharper disable once CppDFALocalValueEscapesFunction
@@ -272,55 +690,11 @@ namespace rebar {
     }
 
     number lexical_analyzer::parse_number(std::string_view const a_raw_string, bool const a_has_separators) {
-        std::string transformed_string;
-
-        // Filter out separators if present.
-        if (a_has_separators) {
-            transformed_string.resize(a_raw_string.size());
-
-            std::size_t convert_index = 0;
-
-            // Scan raw string and place all non-separating characters into the
-            // transformed string.
-            std::ranges::for_each(a_raw_string, [&convert_index, &transformed_string](char const a_char) {
-                if (a_char != '\'') [[likely]] {
-                    transformed_string[convert_index++] = a_char;
-                }
-            });
-
-            // Resize string to match transformed size.
-            transformed_string.resize(convert_index);
-        } else {
-            transformed_string = a_raw_string;
-        }
-
-        return std::stod(transformed_string);
+        return parse_numeric_literal<number>(a_raw_string, a_has_separators);
     }
 
     integer lexical_analyzer::parse_integer(std::string_view const a_raw_string, bool const a_has_separators) {
-        std::string transformed_string;
-
-        // Filter out separators if present.
-        if (a_has_separators) {
-            transformed_string.resize(a_raw_string.size());
-
-            std::size_t convert_index = 0;
-
-            // Scan raw string and place all non-separating characters into the
-            // transformed string.
-            std::ranges::for_each(a_raw_string, [&convert_index, &transformed_string](char const a_char) {
-                if (a_char != '\'') [[likely]] {
-                    transformed_string[convert_index++] = a_char;
-                }
-            });
-
-            // Resize string to match transformed size.
-            transformed_string.resize(convert_index);
-        } else {
-            transformed_string = a_raw_string;
-        }
-
-        return std::stoll(transformed_string);
+        return parse_numeric_literal<integer>(a_raw_string, a_has_separators);
     }
 
 }
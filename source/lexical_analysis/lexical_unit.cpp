@@ -0,0 +1,226 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+#include <fmt/format.h>
+
+#if defined(_WIN32)
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <rebar/lexical_analysis/character_scan.hpp>
+#include <rebar/lexical_analysis/lexical_unit.hpp>
+
+namespace rebar {
+
+    lexical_unit::lexical_unit(std::string a_plaintext) {
+        check_plaintext_size(a_plaintext.size());
+
+        auto const storage = std::make_shared<std::string const>(std::move(a_plaintext));
+
+        m_plaintext = *storage;
+        m_storage = storage;
+    }
+
+    lexical_unit lexical_unit::load(std::string_view const a_plaintext, std::shared_ptr<void const> a_storage) {
+        check_plaintext_size(a_plaintext.size());
+
+        return { std::move(a_storage), a_plaintext };
+    }
+
+    lexical_unit lexical_unit::load_file(std::filesystem::path const & a_path) {
+        auto const fail = [&a_path](std::string_view const a_reason) {
+            throw std::runtime_error(fmt::format("Failed to map source file \"{}\": {}.", a_path.string(), a_reason));
+        };
+
+#if defined(_WIN32)
+        std::ifstream stream(a_path, std::ios::binary);
+
+        if (!stream) {
+            fail("cannot open file");
+        }
+
+        return lexical_unit(std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()));
+#else
+        int const descriptor = ::open(a_path.c_str(), O_RDONLY);
+
+        if (descriptor == -1) {
+            fail("cannot open file");
+        }
+
+        struct stat status{};
+
+        if (::fstat(descriptor, &status) == -1) {
+            ::close(descriptor);
+            fail("cannot read file size");
+        }
+
+        auto const size = static_cast<std::size_t>(status.st_size);
+
+        if (size > max_plaintext_size) {
+            ::close(descriptor);
+            check_plaintext_size(size);
+        }
+
+        // Empty files cannot be mapped.
+        if (size == 0) {
+            ::close(descriptor);
+            return load({});
+        }
+
+        void * const mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+        ::close(descriptor);
+
+        if (mapping == MAP_FAILED) {
+            fail("cannot map file");
+        }
+
+        // Sources are analyzed front to back.
+        ::madvise(mapping, size, MADV_SEQUENTIAL);
+
+        std::shared_ptr<void const> storage(mapping, [size](void const * const a_mapping) {
+            ::munmap(const_cast<void *>(a_mapping), size);
+        });
+
+        return load({ static_cast<char const *>(mapping), size }, std::move(storage));
+#endif
+    }
+
+    void lexical_unit::check_plaintext_size(std::size_t const a_size) {
+        if (a_size > max_plaintext_size) {
+            throw std::length_error(fmt::format(
+                "Plaintext of {} bytes exceeds the maximum of {} bytes addressable by token positions.",
+                a_size,
+                max_plaintext_size
+            ));
+        }
+    }
+
+    std::vector<token> lexical_unit::tokens() const {
+        std::vector<token> result;
+        result.reserve(token_count());
+
+        for (std::size_t i = 0; i < token_count(); ++i) {
+            result.push_back(token_at(i));
+        }
+
+        return result;
+    }
+
+    void lexical_unit::append_tokens(
+        std::span<token_type const> const a_types,
+        std::span<token_payload const> const a_payloads,
+        std::span<std::uint32_t const> const a_positions,
+        std::span<string const> const a_strings
+    ) {
+        m_token_types.insert(m_token_types.end(), a_types.begin(), a_types.end());
+        m_token_payloads.insert(m_token_payloads.end(), a_payloads.begin(), a_payloads.end());
+        m_token_positions.insert(m_token_positions.end(), a_positions.begin(), a_positions.end());
+        m_token_strings.insert(m_token_strings.end(), a_strings.begin(), a_strings.end());
+    }
+
+    void lexical_unit::splice(lexical_unit const & a_edited, std::size_t const a_first, std::size_t const a_last, std::int64_t const a_position_shift) {
+        auto const first = static_cast<std::ptrdiff_t>(a_first);
+        auto const last = static_cast<std::ptrdiff_t>(a_last);
+
+        for (auto & position : std::span(m_token_positions).subspan(a_last)) {
+            position = static_cast<std::uint32_t>(position + a_position_shift);
+        }
+
+        m_token_types.erase(m_token_types.begin() + first, m_token_types.begin() + last);
+        m_token_types.insert(m_token_types.begin() + first, a_edited.m_token_types.begin(), a_edited.m_token_types.end());
+
+        m_token_payloads.erase(m_token_payloads.begin() + first, m_token_payloads.begin() + last);
+        m_token_payloads.insert(m_token_payloads.begin() + first, a_edited.m_token_payloads.begin(), a_edited.m_token_payloads.end());
+
+        m_token_positions.erase(m_token_positions.begin() + first, m_token_positions.begin() + last);
+        m_token_positions.insert(m_token_positions.begin() + first, a_edited.m_token_positions.begin(), a_edited.m_token_positions.end());
+
+        m_token_strings.insert(m_token_strings.end(), a_edited.m_token_strings.begin(), a_edited.m_token_strings.end());
+
+        m_storage = a_edited.m_storage;
+        m_plaintext = a_edited.m_plaintext;
+        m_line_offsets.clear();
+
+        // References to the strings of replaced tokens accumulate across
+        // edits; once they dominate, keep only those still referenced.
+        if (m_token_strings.size() > 2 * m_token_types.size() + 64) {
+            std::unordered_set<string_reference> referenced;
+            std::vector<string> strings;
+
+            for (std::size_t i = 0; i < m_token_types.size(); ++i) {
+                if (m_token_types[i] != token_type::identifier && m_token_types[i] != token_type::string) {
+                    continue;
+                }
+
+                if (referenced.insert(m_token_payloads[i].string_value).second) {
+                    strings.push_back(token_at(i).get_string());
+                }
+            }
+
+            m_token_strings = std::move(strings);
+        }
+    }
+
+    std::size_t lexical_unit::line_count() const {
+        index_lines();
+        return m_line_offsets.size();
+    }
+
+    plaintext_location lexical_unit::location_of(std::size_t const a_position) const {
+        if (a_position > m_plaintext.size()) {
+            throw std::out_of_range(fmt::format(
+                "Position {} exceeds the plaintext ({} characters).",
+                a_position,
+                m_plaintext.size()
+            ));
+        }
+
+        index_lines();
+
+        // The first line begins at zero, so a line is always found.
+        auto const line_end = std::ranges::upper_bound(m_line_offsets, a_position);
+        auto const line = static_cast<std::size_t>(line_end - m_line_offsets.begin());
+
+        return { line, a_position - *(line_end - 1) + 1 };
+    }
+
+    void lexical_unit::index_lines() const {
+        if (!m_line_offsets.empty()) {
+            return;
+        }
+
+        character_scanner const & scanner = default_character_scanner();
+
+        auto const plaintext_begin = m_plaintext.data();
+        auto const plaintext_end = plaintext_begin + m_plaintext.size();
+
+        m_line_offsets.push_back(0);
+
+        for (
+            auto line_end = scanner.skip_line(plaintext_begin, plaintext_end);
+            line_end != plaintext_end;
+            line_end = scanner.skip_line(line_end + 1, plaintext_end)
+        ) {
+            m_line_offsets.push_back(static_cast<std::uint32_t>(line_end + 1 - plaintext_begin));
+        }
+    }
+
+    void lexical_unit::reserve_tokens(std::size_t const a_token_count) {
+        m_token_types.reserve(a_token_count);
+        m_token_payloads.reserve(a_token_count);
+        m_token_positions.reserve(a_token_count);
+    }
+
+}
@@ -0,0 +1,110 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <rebar/lexical_analysis/symbol_trie.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+namespace rebar {
+
+    symbol_trie::symbol_trie(symbol_map const & a_symbol_map) :
+        m_root_edges(nullptr),
+        m_max_length(0)
+    {
+        // Build an intermediate pointer-free tree, then flatten it
+        // breadth-first so that each node's edges are contiguous.
+        struct build_node {
+            std::map<unsigned char, std::size_t> children;
+            bool                                 terminal = false;
+            bool                                 keyword  = false;
+            symbol                               value    = symbol::null;
+        };
+
+        std::vector<build_node> tree(1);
+
+        for (auto const & [text, entry] : a_symbol_map) {
+            if (text.empty()) {
+                continue;
+            }
+
+            m_max_length = std::max(m_max_length, text.size());
+
+            std::size_t current = 0;
+
+            for (unsigned char const c : text) {
+                auto const child = tree[current].children.find(c);
+
+                if (child != tree[current].children.end()) {
+                    current = child->second;
+                    continue;
+                }
+
+                tree[current].children.emplace(c, tree.size());
+                current = tree.size();
+                tree.emplace_back();
+            }
+
+            tree[current].terminal = true;
+            tree[current].value    = entry.first;
+            tree[current].keyword  = entry.second;
+        }
+
+        if (tree.size() > std::numeric_limits<symbol_trie_index>::max()) {
+            throw std::length_error("Symbol map exceeds the capacity of a symbol trie.");
+        }
+
+        // Assign breadth-first indices.
+        std::vector<std::size_t>       order{ 0 };
+        std::vector<symbol_trie_index> indices(tree.size());
+
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            for (auto const child : tree[order[i]].children | std::views::values) {
+                indices[child] = static_cast<symbol_trie_index>(order.size());
+                order.push_back(child);
+            }
+        }
+
+        struct storage {
+            std::vector<symbol_trie_node>      nodes;
+            std::vector<symbol_trie_edge>      edges;
+            std::array<symbol_trie_index, 256> root_edges{};
+        };
+
+        auto tables = std::make_shared<storage>();
+
+        tables->nodes.reserve(tree.size());
+        tables->edges.reserve(tree.size() - 1);
+
+        for (auto const tree_index : order) {
+            build_node const & current = tree[tree_index];
+
+            tables->nodes.push_back({
+                static_cast<std::uint16_t>(tables->edges.size()),
+                static_cast<std::uint16_t>(current.children.size()),
+                current.terminal,
+                current.keyword,
+                current.value,
+            });
+
+            for (auto const & [c, child] : current.children) {
+                tables->edges.push_back({ c, indices[child] });
+            }
+        }
+
+        for (auto const & [c, child] : tree.front().children) {
+            tables->root_edges[c] = indices[child];
+        }
+
+        m_nodes = tables->nodes;
+        m_edges = tables->edges;
+        m_root_edges = tables->root_edges.data();
+        m_storage = std::move(tables);
+    }
+
+}
@@ -0,0 +1,108 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <rebar/lexical_analysis/token_stream.hpp>
+
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace rebar {
+
+    source_reader make_stream_reader(std::istream & a_stream) {
+        return [&a_stream](std::span<char> const a_buffer) -> std::size_t {
+            a_stream.read(a_buffer.data(), static_cast<std::streamsize>(a_buffer.size()));
+            return static_cast<std::size_t>(a_stream.gcount());
+        };
+    }
+
+    source_reader make_file_descriptor_reader(int const a_file_descriptor) {
+        return [a_file_descriptor](std::span<char> const a_buffer) -> std::size_t {
+            while (true) {
+#if defined(_WIN32)
+                auto const result = ::_read(a_file_descriptor, a_buffer.data(), static_cast<unsigned int>(a_buffer.size()));
+#else
+                auto const result = ::read(a_file_descriptor, a_buffer.data(), a_buffer.size());
+#endif
+
+                if (result >= 0) {
+                    return static_cast<std::size_t>(result);
+                }
+
+                if (errno != EINTR) {
+                    throw std::system_error(errno, std::generic_category(), "Failed to read plaintext from file descriptor.");
+                }
+            }
+        };
+    }
+
+    token_stream::token_stream(
+        lexical_analyzer const & a_analyzer,
+        source_reader a_reader,
+        std::size_t const a_chunk_size,
+        std::size_t const a_token_capacity
+    ) :
+        m_analyzer(&a_analyzer),
+        m_reader(std::move(a_reader)),
+        m_chunk_size(a_chunk_size),
+        m_buffer_position(0),
+        m_buffer_analyzed(0),
+        m_input_ended(false),
+        m_tokens(a_token_capacity)
+    {
+        if (a_chunk_size == 0) {
+            throw std::invalid_argument("A token stream must read chunks of at least one character.");
+        }
+    }
+
+    std::optional<positioned_token> token_stream::next() {
+        if (m_tokens.empty()) {
+            refill();
+        }
+
+        if (m_tokens.empty()) {
+            return std::nullopt;
+        }
+
+        return m_tokens.pop();
+    }
+
+    void token_stream::refill() {
+        while (true) {
+            m_buffer_analyzed += m_analyzer->perform_partial_analysis(
+                std::string_view(m_buffer).substr(m_buffer_analyzed),
+                m_buffer_position + m_buffer_analyzed,
+                m_input_ended,
+                m_tokens
+            );
+
+            // Stop once tokens are available, or once nothing is left to
+            // analyze.
+            if (!m_tokens.empty() || m_input_ended) {
+                return;
+            }
+
+            // Discard the analyzed plaintext. What remains is the beginning
+            // of a token that may continue into the next chunk.
+            m_buffer.erase(0, m_buffer_analyzed);
+            m_buffer_position += m_buffer_analyzed;
+            m_buffer_analyzed = 0;
+
+            auto const buffered = m_buffer.size();
+            m_buffer.resize(buffered + m_chunk_size);
+
+            auto const read = m_reader(std::span(m_buffer).subspan(buffered));
+
+            m_buffer.resize(buffered + read);
+            m_input_ended = read == 0;
+        }
+    }
+
+}
@@ -0,0 +1,56 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <memory>
+
+#include <rebar/memory/arena.hpp>
+
+namespace rebar {
+
+    arena::arena(std::size_t const a_chunk_size) noexcept :
+        m_chunk_size(a_chunk_size)
+    {}
+
+    void * arena::do_allocate(std::size_t const a_size, std::size_t const a_alignment) {
+        void * pointer = m_cursor;
+
+        if (std::align(a_alignment, a_size, pointer, m_remaining) == nullptr) [[unlikely]] {
+            // Serve large requests from a dedicated chunk, keeping the
+            // remainder of the current chunk for later requests.
+            auto const chunk_size = a_size + a_alignment > m_chunk_size / 4 ? a_size + a_alignment : m_chunk_size;
+
+            auto & chunk = m_chunks.emplace_back(std::make_unique<std::byte[]>(chunk_size));
+            m_reserved_bytes += chunk_size;
+
+            pointer = chunk.get();
+            std::size_t remaining = chunk_size;
+
+            std::align(a_alignment, a_size, pointer, remaining);
+
+            m_used_bytes += chunk_size - remaining + a_size;
+
+            if (chunk_size != m_chunk_size) {
+                return pointer;
+            }
+
+            m_remaining = remaining;
+        } else {
+            m_used_bytes += static_cast<std::size_t>(static_cast<std::byte *>(pointer) - m_cursor) + a_size;
+        }
+
+        m_cursor = static_cast<std::byte *>(pointer) + a_size;
+        m_remaining -= a_size;
+
+        return pointer;
+    }
+
+    void arena::do_deallocate(void *, std::size_t, std::size_t) {
+        // Memory is only released when the arena is destroyed.
+    }
+
+    bool arena::do_is_equal(std::pmr::memory_resource const & a_other) const noexcept {
+        return this == &a_other;
+    }
+
+}
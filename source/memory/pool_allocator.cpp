@@ -0,0 +1,254 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <unordered_map>
+
+#include <rebar/memory/pool_allocator.hpp>
+
+namespace rebar {
+
+    /// Free lists of a single allocator held by the current thread.
+    struct pool_allocator::thread_cache {
+        std::uint64_t                                   owner_id = 0;
+        std::array<free_block *, pool_size_class_count> heads{};
+        std::array<std::size_t, pool_size_class_count>  counts{};
+    };
+
+    /**
+     * All thread-local caches of the current thread. A thread rarely uses
+     * more than a few environments at once, so a small set of slots is
+     * searched linearly and recycled round-robin.
+     */
+    struct pool_allocator::thread_cache_set {
+        std::array<thread_cache, 4> caches;
+        std::size_t                 next_eviction = 0;
+
+        ~thread_cache_set() {
+            for (auto & cache : caches) {
+                release_cache(cache);
+            }
+        }
+    };
+
+    namespace {
+
+        /// Registry of live allocators, used to return cached blocks safely.
+        std::mutex                                       g_registry_mutex;
+        std::unordered_map<std::uint64_t, void *>        g_registry;
+        std::atomic<std::uint64_t>                       g_next_allocator_id = 1;
+
+    }
+
+    pool_allocator::pool_allocator() :
+        m_id(g_next_allocator_id.fetch_add(1, std::memory_order_relaxed))
+    {
+        std::lock_guard const lock(g_registry_mutex);
+        g_registry.emplace(m_id, this);
+    }
+
+    pool_allocator::~pool_allocator() {
+        {
+            std::lock_guard const lock(g_registry_mutex);
+            g_registry.erase(m_id);
+        }
+
+        // Forget this thread's free lists. Other threads may still hold
+        // stale lists, but allocator identifiers are never reused, so those
+        // lists are never touched again.
+        for (auto & cache : local_cache_set().caches) {
+            if (cache.owner_id == m_id) {
+                cache = thread_cache{};
+            }
+        }
+    }
+
+    void * pool_allocator::allocate(std::size_t const a_size) {
+        auto const class_index = size_class_index(a_size);
+
+        if (class_index == pool_size_class_count) [[unlikely]] {
+            m_oversized_allocations.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(a_size);
+        }
+
+        auto & cache = local_cache();
+
+        if (cache.heads[class_index] == nullptr) [[unlikely]] {
+            refill(cache, class_index);
+        }
+
+        free_block * const block = cache.heads[class_index];
+        cache.heads[class_index] = block->next;
+        --cache.counts[class_index];
+
+        m_classes[class_index].allocations.fetch_add(1, std::memory_order_relaxed);
+
+        return block;
+    }
+
+    void pool_allocator::deallocate(void * const a_pointer, std::size_t const a_size) noexcept {
+        auto const class_index = size_class_index(a_size);
+
+        if (class_index == pool_size_class_count) [[unlikely]] {
+            m_oversized_deallocations.fetch_add(1, std::memory_order_relaxed);
+            ::operator delete(a_pointer);
+            return;
+        }
+
+        m_classes[class_index].deallocations.fetch_add(1, std::memory_order_relaxed);
+
+        auto & cache = local_cache();
+
+        auto * const block = static_cast<free_block *>(a_pointer);
+        block->next = cache.heads[class_index];
+        cache.heads[class_index] = block;
+
+        // Return half of the thread-local list once it grows past the limit.
+        if (++cache.counts[class_index] > pool_thread_cache_limit) [[unlikely]] {
+            free_block * const batch_head = cache.heads[class_index];
+            free_block *       batch_tail = batch_head;
+
+            for (std::size_t i = 1; i < pool_transfer_batch; ++i) {
+                batch_tail = batch_tail->next;
+            }
+
+            cache.heads[class_index] = batch_tail->next;
+            cache.counts[class_index] -= pool_transfer_batch;
+
+            batch_tail->next = nullptr;
+            reclaim(class_index, batch_head, pool_transfer_batch);
+        }
+    }
+
+    pool_statistics pool_allocator::statistics() const noexcept {
+        pool_statistics result{};
+
+        for (std::size_t i = 0; i < pool_size_class_count; ++i) {
+            auto const & current_class = m_classes[i];
+            auto & class_statistics = result.classes[i];
+
+            std::lock_guard const lock(current_class.mutex);
+
+            auto const allocations = current_class.allocations.load(std::memory_order_relaxed);
+
+            class_statistics.block_size         = pool_size_classes[i];
+            class_statistics.chunk_count        = current_class.chunks.size();
+            class_statistics.reserved_blocks    = current_class.reserved_blocks;
+            class_statistics.used_blocks        = allocations - current_class.deallocations.load(std::memory_order_relaxed);
+            class_statistics.shared_free_blocks = current_class.free_count;
+            class_statistics.total_allocations  = allocations;
+        }
+
+        result.oversized_allocations = m_oversized_allocations.load(std::memory_order_relaxed);
+        result.oversized_used        = result.oversized_allocations - m_oversized_deallocations.load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+    pool_allocator::thread_cache_set & pool_allocator::local_cache_set() noexcept {
+        thread_local thread_cache_set cache_set;
+        return cache_set;
+    }
+
+    pool_allocator::thread_cache & pool_allocator::local_cache() noexcept {
+        auto & cache_set = local_cache_set();
+
+        for (auto & cache : cache_set.caches) {
+            if (cache.owner_id == m_id) [[likely]] {
+                return cache;
+            }
+        }
+
+        // Claim a slot for this allocator, returning the previous occupant's
+        // blocks to their owner.
+        auto & cache = cache_set.caches[cache_set.next_eviction];
+        cache_set.next_eviction = (cache_set.next_eviction + 1) % cache_set.caches.size();
+
+        release_cache(cache);
+        cache.owner_id = m_id;
+
+        return cache;
+    }
+
+    void pool_allocator::refill(thread_cache & a_cache, std::size_t const a_class_index) {
+        auto & current_class = m_classes[a_class_index];
+
+        std::lock_guard const lock(current_class.mutex);
+
+        // Carve a new chunk if the shared list cannot fill a batch.
+        if (current_class.free_count < pool_transfer_batch) {
+            auto const block_size  = pool_size_classes[a_class_index];
+            auto const block_count = pool_chunk_size / block_size;
+
+            auto & chunk = current_class.chunks.emplace_back(std::make_unique<std::byte[]>(pool_chunk_size));
+
+            // Link blocks in address order.
+            for (std::size_t i = block_count; i-- > 0;) {
+                auto * const block = reinterpret_cast<free_block *>(chunk.get() + i * block_size);
+                block->next = current_class.free_list;
+                current_class.free_list = block;
+            }
+
+            current_class.free_count      += block_count;
+            current_class.reserved_blocks += block_count;
+        }
+
+        // Detach a batch from the shared list.
+        free_block * const batch_head = current_class.free_list;
+        free_block *       batch_tail = batch_head;
+
+        for (std::size_t i = 1; i < pool_transfer_batch; ++i) {
+            batch_tail = batch_tail->next;
+        }
+
+        current_class.free_list = batch_tail->next;
+        current_class.free_count -= pool_transfer_batch;
+
+        batch_tail->next = a_cache.heads[a_class_index];
+        a_cache.heads[a_class_index] = batch_head;
+        a_cache.counts[a_class_index] += pool_transfer_batch;
+    }
+
+    void pool_allocator::reclaim(std::size_t const a_class_index, free_block * const a_head, std::size_t const a_count) noexcept {
+        if (a_head == nullptr) {
+            return;
+        }
+
+        free_block * tail = a_head;
+
+        while (tail->next != nullptr) {
+            tail = tail->next;
+        }
+
+        auto & current_class = m_classes[a_class_index];
+
+        std::lock_guard const lock(current_class.mutex);
+
+        tail->next = current_class.free_list;
+        current_class.free_list = a_head;
+        current_class.free_count += a_count;
+    }
+
+    void pool_allocator::release_cache(thread_cache & a_cache) noexcept {
+        if (a_cache.owner_id == 0) {
+            return;
+        }
+
+        {
+            // Holding the registry lock keeps the owner alive while its
+            // blocks are returned.
+            std::lock_guard const lock(g_registry_mutex);
+
+            if (auto const it = g_registry.find(a_cache.owner_id); it != g_registry.cend()) {
+                auto * const owner = static_cast<pool_allocator *>(it->second);
+
+                for (std::size_t i = 0; i < pool_size_class_count; ++i) {
+                    owner->reclaim(i, a_cache.heads[i], a_cache.counts[i]);
+                }
+            }
+        }
+
+        a_cache = thread_cache{};
+    }
+
+}
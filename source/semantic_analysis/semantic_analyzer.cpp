@@ -12,34 +12,38 @@
 namespace rebar {
 
     void semantic_analyzer::perform_analysis(semantic_unit & a_semantic_unit, lexical_unit const & a_lexical_unit) const {
-        a_semantic_unit.apply_base_scope(parse_block_scope(a_semantic_unit, a_lexical_unit.tokens()));
+        a_semantic_unit.apply_base_scope(parse_block_scope(a_semantic_unit, a_lexical_unit));
     }
 
-    operation_tree semantic_analyzer::parse_block_scope(semantic_unit & a_semantic_unit, std::span<token const> a_tokens) const {
+    operation_tree semantic_analyzer::parse_block_scope(semantic_unit & a_semantic_unit, lexical_unit const & a_lexical_unit) const {
         operation_tree base_scope(operation::scope);
 
-        auto token_it = a_tokens.begin();
+        // Tokens of the current statement. (Kept outside the loop to reuse
+        // its allocation.)
+        std::vector<token> statement_tokens;
 
-        while (token_it != a_tokens.end()) {
+        std::size_t token_index = 0;
+
+        while (token_index != a_lexical_unit.token_count()) {
             // Testing for non-simple statement constructions.
 
             // Statement parsing.
-            auto const statement_begin = token_it;
+            auto const statement_begin = token_index;
+            auto const statement_end = find_statement_end(a_lexical_unit, statement_begin);
 
-            auto const statement_end = tokens_scoped_increment_find(
-                statement_begin,
-                a_tokens.end(),
-                [](auto const & a_token) {
-                    return a_token == symbol::semicolon;
-                }
-            );
+            token_index = statement_end == a_lexical_unit.token_count() ? statement_end : statement_end + 1;
+
+            // Only the tokens of the statement itself are materialized.
+            statement_tokens.clear();
 
-            token_it = statement_end == a_tokens.end() ? statement_end : statement_end + 1;
+            for (auto i = statement_begin; i < statement_end; ++i) {
+                statement_tokens.push_back(a_lexical_unit.token_at(i));
+            }
 
             base_scope.push_operand(
                 parse_expression(
                     a_semantic_unit,
-                    { statement_begin, statement_end }
+                    statement_tokens
                 )
             );
         }
@@ -47,6 +51,31 @@ namespace rebar {
         return base_scope;
     }
 
+    std::size_t semantic_analyzer::find_statement_end(lexical_unit const & a_lexical_unit, std::size_t const a_begin) const noexcept {
+        auto const types = a_lexical_unit.token_types();
+        auto const payloads = a_lexical_unit.token_payloads();
+
+        std::int64_t scope_level = 0;
+
+        for (auto i = a_begin; i < types.size(); ++i) {
+            if (types[i] != token_type::symbol) {
+                continue;
+            }
+
+            symbol const token_symbol = payloads[i].symbol_value;
+
+            if (std::ranges::find(m_scope_increase_symbols, token_symbol) != m_scope_increase_symbols.end()) {
+                ++scope_level;
+            } else if (std::ranges::find(m_scope_decrease_symbols, token_symbol) != m_scope_decrease_symbols.end()) {
+                --scope_level;
+            } else if (scope_level == 0 && token_symbol == symbol::semicolon) {
+                return i;
+            }
+        }
+
+        return types.size();
+    }
+
     operation_tree_node semantic_analyzer::parse_expression(semantic_unit & a_semantic_unit, std::span<token const> a_tokens) const { // NOLINT(*-no-recursion)
         // If expression is surrounded in parenthesis, redefine tokens to inner content.
         while (
@@ -7,6 +7,27 @@
 
 namespace rebar {
 
+    internal_string * make_internal_string(std::pmr::memory_resource & a_resource, string_engine * const a_engine, std::string_view const a_string, std::size_t const a_reference_count) {
+        auto * const memory = static_cast<std::byte *>(a_resource.allocate(sizeof(internal_string) + a_string.size(), alignof(internal_string)));
+        auto * const characters = reinterpret_cast<char *>(memory + sizeof(internal_string));
+
+        a_string.copy(characters, a_string.size());
+
+        return new (memory) internal_string{
+            a_reference_count,
+            a_engine,
+            std::hash<std::string_view>{}(a_string),
+            std::string_view(characters, a_string.size())
+        };
+    }
+
+    void internal_string_deleter::operator () (internal_string * const a_string) const noexcept {
+        auto const size = sizeof(internal_string) + a_string->string.size();
+
+        a_string->~internal_string();
+        std::pmr::new_delete_resource()->deallocate(a_string, size, alignof(internal_string));
+    }
+
     string string_engine::str(std::string_view const a_string) noexcept {
         // Return reference if already existing.
         if (auto const it = m_strings.find(a_string); it != m_strings.cend()) {
@@ -22,7 +43,10 @@ namespace rebar {
 
     string_reference string_engine::emplace_string(std::string a_string) noexcept {
         // Construct pointer and store view reference.
-        auto string_pointer = std::make_unique<internal_string>(0ull, std::move(a_string));
+        std::unique_ptr<internal_string, internal_string_deleter> string_pointer(
+            make_internal_string(*std::pmr::new_delete_resource(), this, a_string, 0)
+        );
+
         std::string_view string_reference = string_pointer->string;
 
         // Map view to the storage location.
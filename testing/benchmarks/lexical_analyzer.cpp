@@ -0,0 +1,328 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <array>
+#include <cctype>
+#include <sstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <rebar/lexical_analysis/character_class.hpp>
+#include <rebar/lexical_analysis/character_scan.hpp>
+#include <rebar/lexical_analysis/lexical_analyzer.hpp>
+#include <rebar/lexical_analysis/token_stream.hpp>
+#include <rebar/string/string_engine.hpp>
+
+namespace {
+
+    /**
+     * Generate a source corpus of roughly the requested size, made up of
+     * a mix of identifiers, keywords, literals and symbols.
+     */
+    std::string make_corpus(std::size_t const a_size) {
+        constexpr std::array lines{
+            "local_value = first_value + second_value * 42;\n",
+            "if (counter >= 1'000'000 && flag != false) { counter += 1; }\n",
+            "message = \"Hello, world! This is a string literal.\";\n",
+            "escaped = \"Line one\\nLine two\\t\\\"quoted\\\"\";\n",
+            "ratio = -.125 * (width - 3.75) / height_in_pixels;\n",
+            "\tresult[index] = table.lookup(key_name, true) || fallback;\n",
+        };
+
+        std::string corpus;
+        corpus.reserve(a_size + 128);
+
+        for (std::size_t i = 0; corpus.size() < a_size; ++i) {
+            corpus += lines[i % lines.size()];
+        }
+
+        return corpus;
+    }
+
+    void lexical_analysis(benchmark::State & a_state) {
+        rebar::string_engine string_engine;
+        rebar::lexical_analyzer const analyzer(string_engine);
+
+        auto const corpus = make_corpus(a_state.range(0));
+
+        for (auto _ : a_state) {
+            a_state.PauseTiming();
+            rebar::lexical_unit unit(corpus);
+            a_state.ResumeTiming();
+
+            analyzer.perform_analysis(unit);
+            benchmark::DoNotOptimize(unit.token_types().data());
+        }
+
+        a_state.SetBytesProcessed(a_state.iterations() * static_cast<std::int64_t>(corpus.size()));
+    }
+
+    void parallel_analysis(benchmark::State & a_state) {
+        rebar::string_engine string_engine;
+        rebar::lexical_analyzer const analyzer(string_engine);
+
+        auto const corpus = make_corpus(a_state.range(0));
+
+        for (auto _ : a_state) {
+            a_state.PauseTiming();
+            rebar::lexical_unit unit(corpus);
+            a_state.ResumeTiming();
+
+            analyzer.perform_parallel_analysis(unit, a_state.range(1));
+            benchmark::DoNotOptimize(unit.token_types().data());
+        }
+
+        a_state.SetBytesProcessed(a_state.iterations() * static_cast<std::int64_t>(corpus.size()));
+    }
+
+    void incremental_analysis(benchmark::State & a_state) {
+        rebar::string_engine string_engine;
+        rebar::lexical_analyzer const analyzer(string_engine);
+
+        rebar::lexical_unit unit(make_corpus(a_state.range(0)));
+        analyzer.perform_analysis(unit);
+
+        // Alternately insert and remove a character in the middle of an
+        // identifier, leaving the plaintext as it was every other edit.
+        auto const offset = unit.plaintext().find("second_value", unit.plaintext().size() / 2) + 3;
+        bool inserted = false;
+
+        for (auto _ : a_state) {
+            analyzer.perform_incremental_analysis(unit, offset, inserted, inserted ? "" : "x");
+            inserted = !inserted;
+
+            benchmark::DoNotOptimize(unit.token_types().data());
+        }
+    }
+
+    void streaming_analysis(benchmark::State & a_state) {
+        rebar::string_engine string_engine;
+        rebar::lexical_analyzer const analyzer(string_engine);
+
+        auto const corpus = make_corpus(a_state.range(0));
+
+        for (auto _ : a_state) {
+            std::istringstream input(corpus);
+            rebar::token_stream stream(analyzer, rebar::make_stream_reader(input));
+
+            std::size_t count = 0;
+
+            while (stream.next()) {
+                ++count;
+            }
+
+            benchmark::DoNotOptimize(count);
+        }
+
+        a_state.SetBytesProcessed(a_state.iterations() * static_cast<std::int64_t>(corpus.size()));
+    }
+
+    void string_literal_analysis(benchmark::State & a_state) {
+        rebar::string_engine string_engine;
+        rebar::lexical_analyzer const analyzer(string_engine);
+
+        // Long literals with an occasional escape sequence.
+        std::string corpus;
+
+        for (std::size_t i = 0; corpus.size() < static_cast<std::size_t>(a_state.range(0)); ++i) {
+            corpus += "text = \"";
+
+            for (std::size_t j = 0; j < 8; ++j) {
+                corpus += fmt::format("Paragraph {} line {} of a long string literal, containing no escapes", i, j);
+                corpus += j % 4 == 3 ? "\\n" : " ";
+            }
+
+            corpus += "\";\n";
+        }
+
+        for (auto _ : a_state) {
+            a_state.PauseTiming();
+            rebar::lexical_unit unit(corpus);
+            a_state.ResumeTiming();
+
+            analyzer.perform_analysis(unit);
+            benchmark::DoNotOptimize(unit.token_types().data());
+        }
+
+        a_state.SetBytesProcessed(a_state.iterations() * static_cast<std::int64_t>(corpus.size()));
+    }
+
+    void numeric_literal_analysis(benchmark::State & a_state) {
+        rebar::string_engine string_engine;
+        rebar::lexical_analyzer const analyzer(string_engine);
+
+        // A data table embedded in a script.
+        std::string corpus;
+
+        for (std::size_t i = 0; corpus.size() < static_cast<std::size_t>(a_state.range(0)); ++i) {
+            corpus += fmt::format("[{}, {}.{}, 1'{:03}'{:03}, -0.{}],\n", i, i % 977, i % 89, i % 1000, i % 997, i);
+        }
+
+        for (auto _ : a_state) {
+            a_state.PauseTiming();
+            rebar::lexical_unit unit(corpus);
+            a_state.ResumeTiming();
+
+            analyzer.perform_analysis(unit);
+            benchmark::DoNotOptimize(unit.token_types().data());
+        }
+
+        a_state.SetBytesProcessed(a_state.iterations() * static_cast<std::int64_t>(corpus.size()));
+    }
+
+    void analyzer_construction_static(benchmark::State & a_state) {
+        rebar::string_engine string_engine;
+
+        for (auto _ : a_state) {
+            rebar::lexical_analyzer analyzer(string_engine);
+            benchmark::DoNotOptimize(analyzer);
+        }
+    }
+
+    void analyzer_construction_runtime(benchmark::State & a_state) {
+        rebar::string_engine string_engine;
+
+        for (auto _ : a_state) {
+            rebar::lexical_analyzer analyzer(string_engine, rebar::default_symbol_map());
+            benchmark::DoNotOptimize(analyzer);
+        }
+    }
+
+    template <rebar::scan_isa v_isa>
+    void identifier_scan(benchmark::State & a_state) {
+        auto const scanner = rebar::character_scanner_for(v_isa);
+
+        if (scanner == nullptr) {
+            a_state.SkipWithError("Instruction set unavailable.");
+            return;
+        }
+
+        // Long identifiers separated by indentation.
+        std::string corpus;
+
+        while (corpus.size() < static_cast<std::size_t>(a_state.range(0))) {
+            corpus += "\n            some_rather_long_identifier_name_42";
+        }
+
+        auto const end = corpus.data() + corpus.size();
+
+        for (auto _ : a_state) {
+            char const * position = corpus.data();
+
+            while (position != end) {
+                position = scanner->skip_identifier(scanner->skip_whitespace(position, end), end);
+            }
+
+            benchmark::DoNotOptimize(position);
+        }
+
+        a_state.SetBytesProcessed(a_state.iterations() * static_cast<std::int64_t>(corpus.size()));
+    }
+
+    template <rebar::scan_isa v_isa>
+    void line_scan(benchmark::State & a_state) {
+        auto const scanner = rebar::character_scanner_for(v_isa);
+
+        if (scanner == nullptr) {
+            a_state.SkipWithError("Instruction set unavailable.");
+            return;
+        }
+
+        auto const corpus = make_corpus(a_state.range(0));
+        auto const end = corpus.data() + corpus.size();
+
+        for (auto _ : a_state) {
+            std::size_t count = 0;
+
+            for (char const * position = scanner->skip_line(corpus.data(), end); position != end; position = scanner->skip_line(position + 1, end)) {
+                ++count;
+            }
+
+            benchmark::DoNotOptimize(count);
+        }
+
+        a_state.SetBytesProcessed(a_state.iterations() * static_cast<std::int64_t>(corpus.size()));
+    }
+
+    void token_locations(benchmark::State & a_state) {
+        rebar::string_engine string_engine;
+        rebar::lexical_analyzer const analyzer(string_engine);
+
+        auto const corpus = make_corpus(a_state.range(0));
+
+        auto analyzed = rebar::lexical_unit::load(corpus);
+        analyzer.perform_analysis(analyzed);
+
+        // Every iteration builds the line index of a fresh unit, then
+        // locates every token.
+        for (auto _ : a_state) {
+            a_state.PauseTiming();
+            auto unit = analyzed;
+            a_state.ResumeTiming();
+
+            std::size_t lines = 0;
+
+            for (std::size_t i = 0; i < unit.token_count(); ++i) {
+                lines += unit.token_location(i).line;
+            }
+
+            benchmark::DoNotOptimize(lines);
+        }
+
+        a_state.SetItemsProcessed(a_state.iterations() * static_cast<std::int64_t>(analyzed.token_count()));
+    }
+
+    void character_classification_table(benchmark::State & a_state) {
+        auto const corpus = make_corpus(a_state.range(0));
+
+        for (auto _ : a_state) {
+            std::size_t count = 0;
+
+            for (unsigned char const c : corpus) {
+                count += rebar::is_character_class(c, rebar::character_class::identifier_continue);
+            }
+
+            benchmark::DoNotOptimize(count);
+        }
+
+        a_state.SetBytesProcessed(a_state.iterations() * static_cast<std::int64_t>(corpus.size()));
+    }
+
+    void character_classification_ctype(benchmark::State & a_state) {
+        auto const corpus = make_corpus(a_state.range(0));
+
+        for (auto _ : a_state) {
+            std::size_t count = 0;
+
+            for (unsigned char const c : corpus) {
+                count += std::isalnum(c) || c == '_';
+            }
+
+            benchmark::DoNotOptimize(count);
+        }
+
+        a_state.SetBytesProcessed(a_state.iterations() * static_cast<std::int64_t>(corpus.size()));
+    }
+
+}
+
+BENCHMARK(lexical_analysis)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(parallel_analysis)->ArgsProduct({ { 16 << 20 }, { 1, 2, 4, 8 } })->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(incremental_analysis)->Arg(4 << 20)->Unit(benchmark::kMicrosecond);
+BENCHMARK(streaming_analysis)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(string_literal_analysis)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(numeric_literal_analysis)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(analyzer_construction_static);
+BENCHMARK(analyzer_construction_runtime);
+BENCHMARK(identifier_scan<rebar::scan_isa::scalar>)->Arg(1 << 20);
+BENCHMARK(identifier_scan<rebar::scan_isa::sse2>)->Arg(1 << 20);
+BENCHMARK(identifier_scan<rebar::scan_isa::avx2>)->Arg(1 << 20);
+BENCHMARK(line_scan<rebar::scan_isa::scalar>)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(line_scan<rebar::scan_isa::sse2>)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(line_scan<rebar::scan_isa::avx2>)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(token_locations)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(character_classification_table)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(character_classification_ctype)->Arg(4 << 20)->Unit(benchmark::kMillisecond);
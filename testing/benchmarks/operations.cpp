@@ -0,0 +1,94 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <array>
+
+#include <benchmark/benchmark.h>
+
+#include <rebar/environment/environment.hpp>
+#include <rebar/environment/operations.hpp>
+
+namespace {
+
+    template <rebar::operation v_operation>
+    void integer_fast_path(benchmark::State & a_state) {
+        rebar::object lhs(rebar::integer(1));
+        rebar::object const rhs(rebar::integer(3));
+
+        for (auto _ : a_state) {
+            benchmark::DoNotOptimize(lhs);
+            auto result = rebar::perform_operation<v_operation>(lhs, rhs);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    template <rebar::operation v_operation>
+    void number_fast_path(benchmark::State & a_state) {
+        rebar::object lhs(1.5);
+        rebar::object const rhs(3.25);
+
+        for (auto _ : a_state) {
+            benchmark::DoNotOptimize(lhs);
+            auto result = rebar::perform_operation<v_operation>(lhs, rhs);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    template <rebar::operation v_operation>
+    void mixed_matrix(benchmark::State & a_state) {
+        rebar::object lhs(rebar::integer(3));
+        rebar::object const rhs(0.5);
+
+        for (auto _ : a_state) {
+            benchmark::DoNotOptimize(lhs);
+            auto result = rebar::perform_operation<v_operation>(lhs, rhs);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    void runtime_dispatch(benchmark::State & a_state) {
+        using enum rebar::operation;
+
+        constexpr std::array operations{ addition, multiplication, lesser, equality };
+
+        std::array<rebar::object, 4> const operands{
+            rebar::object(rebar::integer(7)),
+            rebar::object(2.5),
+            rebar::object(rebar::integer(-3)),
+            rebar::object(0.125),
+        };
+
+        std::size_t i = 0;
+
+        for (auto _ : a_state) {
+            auto result = rebar::perform_operation(operations[i % operations.size()], operands[i % operands.size()], operands[(i + 1) % operands.size()]);
+            benchmark::DoNotOptimize(result);
+            ++i;
+        }
+    }
+
+    void string_equality(benchmark::State & a_state) {
+        rebar::environment env;
+
+        rebar::object const lhs(env.str("rebar"));
+        rebar::object const rhs(env.str("rebar"));
+
+        for (auto _ : a_state) {
+            auto result = rebar::perform_operation<rebar::operation::equality>(lhs, rhs);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+}
+
+BENCHMARK(integer_fast_path<rebar::operation::addition>);
+BENCHMARK(integer_fast_path<rebar::operation::multiplication>);
+BENCHMARK(integer_fast_path<rebar::operation::lesser>);
+BENCHMARK(integer_fast_path<rebar::operation::division>);
+BENCHMARK(number_fast_path<rebar::operation::addition>);
+BENCHMARK(number_fast_path<rebar::operation::lesser>);
+BENCHMARK(mixed_matrix<rebar::operation::addition>);
+BENCHMARK(mixed_matrix<rebar::operation::equality>);
+BENCHMARK(runtime_dispatch);
+BENCHMARK(string_equality);
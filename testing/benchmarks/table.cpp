@@ -0,0 +1,85 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <benchmark/benchmark.h>
+
+#include <rebar/environment/environment.hpp>
+#include <rebar/environment/table.hpp>
+
+namespace {
+
+    rebar::object make_table(rebar::environment & a_env, rebar::integer const a_size) {
+        auto table = a_env.table();
+
+        for (rebar::integer i = 0; i < a_size; ++i) {
+            table.table_set(rebar::object(i * 7), rebar::object(i));
+        }
+
+        return table;
+    }
+
+    void table_iteration(benchmark::State & a_state) {
+        rebar::environment env;
+        auto const table = make_table(env, a_state.range(0));
+
+        for (auto _ : a_state) {
+            rebar::integer sum = 0;
+
+            for (auto const & entry : table.table_entries()) {
+                sum += entry.value.get_integer();
+            }
+
+            benchmark::DoNotOptimize(sum);
+        }
+
+        a_state.SetItemsProcessed(a_state.iterations() * a_state.range(0));
+    }
+
+    void table_lookup(benchmark::State & a_state) {
+        rebar::environment env;
+        auto const table = make_table(env, a_state.range(0));
+
+        rebar::integer i = 0;
+
+        for (auto _ : a_state) {
+            auto result = table.table_get(rebar::object(i * 7));
+            benchmark::DoNotOptimize(result);
+            i = (i + 1) % a_state.range(0);
+        }
+    }
+
+    void table_array_lookup(benchmark::State & a_state) {
+        rebar::environment env;
+        auto table = env.table();
+
+        for (rebar::integer i = 0; i < a_state.range(0); ++i) {
+            table.table_set(rebar::object(i), rebar::object(i));
+        }
+
+        rebar::integer i = 0;
+
+        for (auto _ : a_state) {
+            auto result = table.table_get(rebar::object(i));
+            benchmark::DoNotOptimize(result);
+            i = (i + 1) % a_state.range(0);
+        }
+    }
+
+    void table_insertion(benchmark::State & a_state) {
+        rebar::environment env;
+
+        for (auto _ : a_state) {
+            auto table = make_table(env, a_state.range(0));
+            benchmark::DoNotOptimize(table);
+        }
+
+        a_state.SetItemsProcessed(a_state.iterations() * a_state.range(0));
+    }
+
+}
+
+BENCHMARK(table_iteration)->Arg(8)->Arg(1024)->Arg(65536);
+BENCHMARK(table_lookup)->Arg(8)->Arg(1024)->Arg(65536);
+BENCHMARK(table_array_lookup)->Arg(8)->Arg(1024)->Arg(65536);
+BENCHMARK(table_insertion)->Arg(8)->Arg(1024);
@@ -0,0 +1,109 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <rebar/environment/environment.hpp>
+
+class array_view_test : public testing::Test {
+protected:
+    rebar::environment env;
+};
+
+TEST_F(array_view_test, read_only) {
+    std::vector<double> host{ 1.5, 2.0, 3.25 };
+
+    auto array = env.array_view(host);
+
+    ASSERT_EQ(array.array_length(), 3);
+    EXPECT_EQ(array.array_at(0).get_number(), 1.5);
+
+    // The array views the host memory in place.
+    host[1] = 4.0;
+    EXPECT_EQ(array.array_at(1).get_number(), 4.0);
+
+    // Viewed elements compare and hash like the equal object arrays.
+    auto copy = env.array(3);
+
+    for (auto const value : host) {
+        copy.array_push(rebar::object(value));
+    }
+
+    EXPECT_TRUE(array.equals(copy));
+    EXPECT_EQ(array.hash(), copy.hash());
+    EXPECT_FALSE(array.hash_memoized());
+
+    // Mutating a read-only view copies its elements first.
+    array.array_set(0, rebar::object(env.str("first")));
+
+    EXPECT_EQ(host[0], 1.5);
+    EXPECT_EQ(array.array_at(0).string_view(), "first");
+    EXPECT_EQ(array.array_at(2).get_number(), 3.25);
+
+    host[2] = 0.0;
+    EXPECT_EQ(array.array_at(2).get_number(), 3.25);
+}
+
+TEST_F(array_view_test, read_write) {
+    std::vector<std::int64_t> host{ 1, 2, 3, 4 };
+
+    auto array = env.array_view(std::span(host), rebar::array_access::read_write);
+    auto const alias = array;
+
+    array.array_set(0, rebar::object(rebar::integer(10)));
+    array.array_set(1, rebar::object(20.0));
+
+    EXPECT_EQ(host[0], 10);
+    EXPECT_EQ(host[1], 20);
+    EXPECT_EQ(alias.array_at(0).get_integer(), 10);
+
+    EXPECT_THROW(array.array_set(2, rebar::object(2.5)), std::invalid_argument);
+    EXPECT_THROW(array.array_set(2, rebar::object(env.str("three"))), std::invalid_argument);
+    EXPECT_THROW(array.array_set(4, rebar::object(rebar::integer(5))), std::out_of_range);
+    EXPECT_THROW(array.array_push(rebar::object(rebar::integer(5))), std::logic_error);
+
+    std::vector<double> numbers(2);
+    auto number_array = env.array_view(std::span(numbers), rebar::array_access::read_write);
+
+    number_array.array_set(0, rebar::object(rebar::integer(3)));
+    number_array.array_set(1, rebar::object(0.5));
+
+    EXPECT_EQ(numbers[0], 3.0);
+    EXPECT_EQ(numbers[1], 0.5);
+}
+
+TEST_F(array_view_test, owner) {
+    auto host = std::make_shared<std::vector<std::int64_t>>(1000, 7);
+    std::weak_ptr<std::vector<std::int64_t>> const observer = host;
+
+    auto array = env.array_view(std::span<std::int64_t const>(*host), host);
+    host.reset();
+
+    // The array keeps the host container alive.
+    ASSERT_FALSE(observer.expired());
+    EXPECT_EQ(array.array_at(999).get_integer(), 7);
+
+    // Converting to object storage no longer needs the host memory.
+    array.array_push(rebar::object(rebar::integer(8)));
+    EXPECT_TRUE(observer.expired());
+    EXPECT_EQ(array.array_length(), 1001);
+
+    auto other = std::make_shared<std::vector<double>>(4, 1.0);
+    std::weak_ptr<std::vector<double>> const other_observer = other;
+
+    {
+        std::span<double const> const elements(*other);
+
+        auto const view = env.array_view(elements, std::move(other));
+        EXPECT_FALSE(other_observer.expired());
+    }
+
+    EXPECT_TRUE(other_observer.expired());
+}
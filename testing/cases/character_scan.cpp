@@ -0,0 +1,98 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <rebar/lexical_analysis/character_scan.hpp>
+
+class character_scan_test : public testing::Test {
+protected:
+    static std::vector<rebar::character_scanner const *> available_scanners() {
+        std::vector<rebar::character_scanner const *> scanners;
+
+        for (auto const isa : { rebar::scan_isa::scalar, rebar::scan_isa::sse2, rebar::scan_isa::avx2 }) {
+            if (auto const scanner = rebar::character_scanner_for(isa); scanner != nullptr) {
+                scanners.push_back(scanner);
+            }
+        }
+
+        return scanners;
+    }
+};
+
+TEST_F(character_scan_test, runs) {
+    auto const & scanner = rebar::default_character_scanner();
+
+    std::string const text = "    \t\r\n identifier_123+ 1'000.25;";
+    auto const begin = text.data();
+    auto const end = text.data() + text.size();
+
+    auto const identifier = scanner.skip_whitespace(begin, end);
+    EXPECT_EQ(identifier - begin, 8);
+
+    auto const symbol = scanner.skip_identifier(identifier, end);
+    EXPECT_EQ(std::string_view(identifier, symbol), "identifier_123");
+
+    auto const number = scanner.skip_whitespace(symbol + 1, end);
+    EXPECT_EQ(std::string_view(number, scanner.skip_number(number, end)), "1'000.25");
+
+    std::string_view const literal = R"(long string content\n")";
+    EXPECT_EQ(scanner.skip_string(literal.data(), literal.data() + literal.size()) - literal.data(), 19);
+
+    std::string_view const lines = "first line\r\nsecond";
+    EXPECT_EQ(scanner.skip_line(lines.data(), lines.data() + lines.size()) - lines.data(), 11);
+
+    EXPECT_EQ(scanner.skip_identifier(end, end), end);
+    EXPECT_EQ(scanner.skip_whitespace(symbol, end), symbol);
+}
+
+TEST_F(character_scan_test, implementations_agree) {
+    auto const scanners = available_scanners();
+    auto const & scalar = *scanners.front();
+
+    ASSERT_EQ(scalar.isa, rebar::scan_isa::scalar);
+
+    // Runs of every length around the vector widths, terminated by every
+    // byte value, at unaligned offsets.
+    std::mt19937 generator(42);
+    std::string const members[] = { " \t\r\n", "abcxyzABCXYZ0189_", "0123456789.'", "ab '\t{}\x80\xFF", "ab \t\r\"\\{}\x80\xFF" };
+
+    for (std::size_t run = 0; run < 5; ++run) {
+        for (std::size_t length = 0; length < 80; ++length) {
+            for (int terminator = 0; terminator < 256; ++terminator) {
+                std::string text(1 + length % 7, ' ');
+
+                for (std::size_t i = 0; i < length; ++i) {
+                    text += members[run][generator() % members[run].size()];
+                }
+
+                text += static_cast<char>(terminator);
+                text += "abc";
+
+                auto const begin = text.data() + 1 + length % 7;
+                auto const end = text.data() + text.size();
+
+                auto const scan = [run](rebar::character_scanner const & a_scanner) {
+                    switch (run) {
+                        case 0:  return a_scanner.skip_whitespace;
+                        case 1:  return a_scanner.skip_identifier;
+                        case 2:  return a_scanner.skip_number;
+                        case 3:  return a_scanner.skip_string;
+                        default: return a_scanner.skip_line;
+                    }
+                };
+
+                auto const expected = scan(scalar)(begin, end);
+
+                for (auto const scanner : scanners) {
+                    ASSERT_EQ(scan(*scanner)(begin, end), expected)
+                        << "isa " << static_cast<int>(scanner->isa) << ", run " << run << ", length " << length << ", terminator " << terminator;
+                }
+            }
+        }
+    }
+}
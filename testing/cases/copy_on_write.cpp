@@ -0,0 +1,117 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <rebar/environment/array.hpp>
+#include <rebar/environment/environment.hpp>
+#include <rebar/environment/table.hpp>
+
+class copy_on_write_test : public testing::Test {
+protected:
+    rebar::environment env;
+
+    [[nodiscard]]
+    std::size_t allocations() const {
+        auto const statistics = env.allocator_statistics();
+
+        std::size_t total = 0;
+
+        for (auto const & class_statistics : statistics.classes) {
+            total += class_statistics.total_allocations;
+        }
+
+        return total;
+    }
+};
+
+TEST_F(copy_on_write_test, arrays) {
+    auto original = env.array();
+    original.array_push(rebar::object(rebar::integer(1)));
+    original.array_push(rebar::object(rebar::integer(2)));
+
+    auto const before_copy = allocations();
+
+    // Copying shares the payload.
+    auto copy = original;
+    EXPECT_TRUE(copy.identical(original));
+    EXPECT_EQ(allocations(), before_copy);
+
+    // The first mutation of a shared payload copies it.
+    copy.array_push(rebar::object(rebar::integer(3)));
+    EXPECT_FALSE(copy.identical(original));
+    EXPECT_EQ(allocations(), before_copy + 1);
+
+    EXPECT_EQ(original.array_length(), 2);
+    EXPECT_EQ(copy.array_length(), 3);
+
+    // Later mutations of an unshared payload happen in place.
+    copy.array_set(0, rebar::object(rebar::integer(10)));
+    copy.array_push(rebar::object(rebar::integer(4)));
+    EXPECT_EQ(allocations(), before_copy + 1);
+
+    EXPECT_EQ(original.array_at(0).get_integer(), 1);
+    EXPECT_EQ(copy.array_at(0).get_integer(), 10);
+}
+
+TEST_F(copy_on_write_test, tables) {
+    auto original = env.table();
+    original.table_set(rebar::object(env.str("key")), rebar::object(env.str("value")));
+
+    auto copy = original;
+    copy.table_set(rebar::object(env.str("key")), rebar::object(env.str("changed")));
+    copy.table_set(rebar::object(env.str("other")), rebar::object(rebar::integer(1)));
+
+    EXPECT_EQ(original.table_size(), 1);
+    EXPECT_EQ(original.table_get(rebar::object(env.str("key"))).string_view(), "value");
+    EXPECT_EQ(copy.table_size(), 2);
+    EXPECT_EQ(copy.table_get(rebar::object(env.str("key"))).string_view(), "changed");
+}
+
+TEST_F(copy_on_write_test, nested_containers) {
+    auto inner = env.array();
+    inner.array_push(rebar::object(rebar::integer(1)));
+
+    auto outer = env.table();
+    outer.table_set(rebar::object(env.str("inner")), inner);
+
+    // Mutating a retrieved element does not affect its container.
+    auto retrieved = outer.table_get(rebar::object(env.str("inner")));
+    retrieved.array_push(rebar::object(rebar::integer(2)));
+
+    EXPECT_EQ(outer.table_get(rebar::object(env.str("inner"))).array_length(), 1);
+    EXPECT_EQ(inner.array_length(), 1);
+
+    // Storing the mutated element back updates the container.
+    outer.table_set(rebar::object(env.str("inner")), retrieved);
+    EXPECT_EQ(outer.table_get(rebar::object(env.str("inner"))).array_length(), 2);
+
+    // Keys cannot be changed through other references.
+    auto key = env.array();
+    key.array_push(rebar::object(rebar::integer(7)));
+
+    outer.table_set(key, rebar::object(rebar::_true));
+    key.array_push(rebar::object(rebar::integer(8)));
+
+    auto lookup = env.array();
+    lookup.array_push(rebar::object(rebar::integer(7)));
+    EXPECT_EQ(outer.table_get(lookup).get_boolean(), rebar::_true);
+}
+
+TEST_F(copy_on_write_test, payload_release) {
+    auto const array_block_size = rebar::pool_size_classes[rebar::pool_allocator::size_class_index(sizeof(rebar::internal_array))];
+
+    {
+        auto original = env.array();
+        auto copy = original;
+
+        copy.array_push(rebar::object(rebar::integer(1)));
+        EXPECT_EQ(env.allocator_statistics().used_bytes(), 2 * array_block_size);
+
+        original = rebar::object();
+        EXPECT_EQ(env.allocator_statistics().used_bytes(), array_block_size);
+    }
+
+    EXPECT_EQ(env.allocator_statistics().used_bytes(), 0);
+}
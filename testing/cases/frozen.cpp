@@ -0,0 +1,137 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <rebar/environment/environment.hpp>
+#include <rebar/environment/frozen.hpp>
+#include <rebar/environment/operations.hpp>
+
+namespace {
+
+    rebar::integer add(rebar::integer const a_lhs, rebar::integer const a_rhs) {
+        return a_lhs + a_rhs;
+    }
+
+}
+
+class frozen_test : public testing::Test {
+protected:
+    rebar::environment env;
+
+    /// Builds { name = "config", limits = [1, 2, 3], nested = { limits = <same array> } }.
+    rebar::object make_configuration() {
+        auto limits = env.array();
+
+        for (rebar::integer i = 1; i <= 3; ++i) {
+            limits.array_push(rebar::object(i));
+        }
+
+        auto nested = env.table();
+        nested.table_set(rebar::object(env.str("limits")), limits);
+
+        auto configuration = env.table();
+        configuration.table_set(rebar::object(env.str("name")), rebar::object(env.str("config")));
+        configuration.table_set(rebar::object(env.str("limits")), limits);
+        configuration.table_set(rebar::object(env.str("nested")), nested);
+
+        return configuration;
+    }
+};
+
+TEST_F(frozen_test, structure) {
+    auto const configuration = make_configuration();
+    auto const graph = rebar::frozen_graph::freeze(configuration);
+    auto const & root = graph.root();
+
+    EXPECT_TRUE(root.is_frozen());
+    EXPECT_FALSE(configuration.is_frozen());
+    EXPECT_GT(graph.size(), 0);
+
+    // The frozen copy is structurally equal to its source.
+    EXPECT_TRUE(root.equals(configuration));
+    EXPECT_EQ(root.hash(), configuration.hash());
+
+    // Frozen strings are looked up by the characters of interned strings.
+    auto const name = root.table_get(rebar::object(env.str("name")));
+    ASSERT_TRUE(name.is_string());
+    EXPECT_TRUE(name.is_frozen());
+    EXPECT_EQ(name.string_view(), "config");
+    EXPECT_EQ(rebar::perform_operation<rebar::operation::equality>(name, rebar::object(env.str("config"))).get_boolean(), rebar::_true);
+
+    // Shared payloads are frozen once.
+    auto const limits = root.table_get(rebar::object(env.str("limits")));
+    auto const nested_limits = root.table_get(rebar::object(env.str("nested"))).table_get(rebar::object(env.str("limits")));
+    EXPECT_TRUE(limits.identical(nested_limits));
+    EXPECT_EQ(limits.array_length(), 3);
+    EXPECT_EQ(limits.array_at(2).get_integer(), 3);
+
+    // Frozen strings can be concatenated with strings of an environment.
+    auto const concatenated = rebar::perform_operation<rebar::operation::addition>(name, rebar::object(env.str("!")));
+    EXPECT_EQ(concatenated.string_view(), "config!");
+    EXPECT_FALSE(concatenated.is_frozen());
+}
+
+TEST_F(frozen_test, immutability) {
+    auto const graph = rebar::frozen_graph::freeze(make_configuration());
+
+    auto root = graph.root();
+    auto limits = root.table_get(rebar::object(env.str("limits")));
+
+    EXPECT_THROW(root.table_set(rebar::object(env.str("name")), rebar::object(rebar::integer(1))), std::logic_error);
+    EXPECT_THROW(limits.array_push(rebar::object(rebar::integer(4))), std::logic_error);
+    EXPECT_THROW(limits.array_set(0, rebar::object(rebar::integer(0))), std::logic_error);
+
+    // Frozen graphs only hold tables, arrays, strings and simple values.
+    auto holder = env.array();
+    holder.array_push(env.function<&add>());
+    EXPECT_THROW(static_cast<void>(rebar::frozen_graph::freeze(holder)), std::invalid_argument);
+}
+
+TEST_F(frozen_test, independent_of_source) {
+    auto configuration = make_configuration();
+    auto const graph = rebar::frozen_graph::freeze(configuration);
+
+    configuration.table_set(rebar::object(env.str("name")), rebar::object(env.str("changed")));
+    configuration = rebar::object();
+
+    EXPECT_EQ(graph.root().table_get(rebar::object(env.str("name"))).string_view(), "config");
+}
+
+TEST_F(frozen_test, concurrent_readers) {
+    auto const graph = rebar::frozen_graph::freeze(make_configuration());
+
+    std::vector<std::thread> readers;
+    std::vector<rebar::integer> sums(8, 0);
+
+    for (std::size_t i = 0; i < sums.size(); ++i) {
+        readers.emplace_back([&graph, &sums, i] {
+            // Every reader uses its own environment.
+            rebar::environment local;
+
+            auto const key = rebar::object(local.str("limits"));
+
+            for (int iteration = 0; iteration < 1000; ++iteration) {
+                auto const root = graph.root();
+                auto const limits = root.table_get(key);
+
+                for (std::size_t element = 0; element < limits.array_length(); ++element) {
+                    sums[i] += limits.array_at(element).get_integer();
+                }
+            }
+        });
+    }
+
+    for (auto & reader : readers) {
+        reader.join();
+    }
+
+    for (auto const sum : sums) {
+        EXPECT_EQ(sum, 6000);
+    }
+}
@@ -2,10 +2,20 @@
 // Created by maxng on 7/17/2024.
 //
 
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 
 #include <rebar/string/string_engine.hpp>
+#include <rebar/lexical_analysis/character_class.hpp>
 #include <rebar/lexical_analysis/lexical_analyzer.hpp>
+#include <rebar/lexical_analysis/symbol_trie.hpp>
 
 class lexical_analyzer_test : public testing::Test {
 protected:
@@ -25,6 +35,18 @@ TEST_F(lexical_analyzer_test, basic_string_escape_sequences) {
     EXPECT_EQ(processed_string, "Hello, \n\tworld!");
 }
 
+TEST_F(lexical_analyzer_test, known_escape_positions) {
+    auto const raw_string = R"(\"quoted\" and \\)";
+    std::size_t const escape_offsets[] = { 0, 8, 15 };
+
+    EXPECT_EQ(m_lexical_analyzer.process_string(raw_string, escape_offsets), R"("quoted" and \)");
+    EXPECT_EQ(m_lexical_analyzer.process_string(raw_string), R"("quoted" and \)");
+
+    // Escapes at either end of the string, and a dangling backslash.
+    EXPECT_EQ(m_lexical_analyzer.process_string(R"(\tend\n)"), "\tend\n");
+    EXPECT_EQ(m_lexical_analyzer.process_string(R"(end\)"), R"(end\)");
+}
+
 TEST_F(lexical_analyzer_test, advanced_string_escape_sequences) {
     // TODO: Implement tests for Unicode, hex, etc. escape sequences.
 }
@@ -81,6 +103,24 @@ TEST_F(lexical_analyzer_test, number_parsing) {
     EXPECT_EQ(result, -.123'456);
 }
 
+TEST_F(lexical_analyzer_test, numeric_literal_limits) {
+    EXPECT_EQ(rebar::lexical_analyzer::parse_integer("9'223'372'036'854'775'807"), std::numeric_limits<rebar::integer>::max());
+    EXPECT_EQ(rebar::lexical_analyzer::parse_integer("-9223372036854775808", false), std::numeric_limits<rebar::integer>::min());
+
+    EXPECT_THROW(static_cast<void>(rebar::lexical_analyzer::parse_integer("9'223'372'036'854'775'808")), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(rebar::lexical_analyzer::parse_integer("-")), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(rebar::lexical_analyzer::parse_number("-.")), std::invalid_argument);
+
+    // Literals longer than the separator buffer.
+    std::string long_literal = "0.";
+
+    for (int i = 0; i < 100; ++i) {
+        long_literal += "12'";
+    }
+
+    EXPECT_DOUBLE_EQ(rebar::lexical_analyzer::parse_number(long_literal), 12.0 / 99.0);
+}
+
 TEST_F(lexical_analyzer_test, token_parsing_strings) {
     {
         rebar::lexical_unit lu(R"(hello"Hello, world!"goodbye)");
@@ -122,6 +162,39 @@ TEST_F(lexical_analyzer_test, token_parsing_strings) {
     }
 }
 
+TEST_F(lexical_analyzer_test, token_parsing_escaped_strings) {
+    {
+        rebar::lexical_unit lu(R"(a "say \"hi\"\n" b "\\" "unterminated \")");
+
+        m_lexical_analyzer.perform_analysis(lu);
+
+        auto const tokens = lu.tokens();
+
+        ASSERT_EQ(tokens.size(), 5);
+
+        ASSERT_TRUE(tokens[1].is_string());
+        EXPECT_EQ(tokens[1].get_string().view(), "say \"hi\"\n");
+
+        ASSERT_TRUE(tokens[3].is_string());
+        EXPECT_EQ(tokens[3].get_string().view(), "\\");
+
+        ASSERT_TRUE(tokens[4].is_string());
+        EXPECT_EQ(tokens[4].get_string().view(), "unterminated \"");
+    }
+    {
+        // Long literals span several vector blocks.
+        std::string const content(1000, 'x');
+        rebar::lexical_unit lu("\"" + content + "\\t" + content + "\"");
+
+        m_lexical_analyzer.perform_analysis(lu);
+
+        auto const tokens = lu.tokens();
+
+        ASSERT_EQ(tokens.size(), 1);
+        EXPECT_EQ(tokens[0].get_string().view(), content + "\t" + content);
+    }
+}
+
 TEST_F(lexical_analyzer_test, token_parsing_symbols) {
     {
         rebar::lexical_unit lu(R"(hello+world)");
@@ -318,4 +391,438 @@ TEST_F(lexical_analyzer_test, token_parsing_number) {
     }
 }
 
+TEST_F(lexical_analyzer_test, character_classes) {
+    using rebar::character_class;
+
+    for (int c = 0; c < 256; ++c) {
+        auto const character = static_cast<unsigned char>(c);
+        bool const ascii = c < 128;
+
+        EXPECT_EQ(rebar::is_character_class(character, character_class::digit), ascii && std::isdigit(c));
+        EXPECT_EQ(rebar::is_character_class(character, character_class::identifier_start), ascii && (std::isalpha(c) || c == '_'));
+        EXPECT_EQ(rebar::is_character_class(character, character_class::identifier_continue), ascii && (std::isalnum(c) || c == '_'));
+    }
+
+    EXPECT_TRUE(rebar::is_character_class('\t', character_class::whitespace));
+    EXPECT_FALSE(rebar::is_character_class('\v', character_class::whitespace));
+    EXPECT_TRUE(rebar::is_character_class('_', character_class::identifier_start | character_class::whitespace));
+    EXPECT_FALSE(rebar::is_character_class(0xE9, character_class::identifier_start | character_class::whitespace));
+}
+
+TEST_F(lexical_analyzer_test, symbol_trie) {
+    rebar::symbol_trie const trie(rebar::default_symbol_map());
+
+    // Every symbol matches itself in full.
+    for (auto const & [text, entry] : rebar::default_symbol_map()) {
+        auto const match = trie.longest_match(text);
+
+        EXPECT_EQ(match.length, text.size());
+        EXPECT_EQ(match.value, entry.first);
+        EXPECT_EQ(match.keyword, entry.second);
+    }
+
+    EXPECT_EQ(trie.longest_match("&&=x").value, rebar::symbol::double_ampersand_equals);
+    EXPECT_EQ(trie.longest_match("&&x").value, rebar::symbol::double_ampersand);
+    EXPECT_EQ(trie.longest_match("||").length, 2);
+    EXPECT_EQ(trie.longest_match("truex").length, 4);
+    EXPECT_EQ(trie.longest_match("tru").length, 0);
+    EXPECT_EQ(trie.longest_match("hello").length, 0);
+    EXPECT_EQ(trie.longest_match("").length, 0);
+
+    // Prefixes that are not symbols themselves fall back to the longest
+    // complete symbol.
+    rebar::symbol_trie const custom({
+        { "<",   { rebar::symbol::carrot_left,  false } },
+        { "<<<", { rebar::symbol::carrot_right, false } },
+    });
+
+    EXPECT_EQ(custom.longest_match("<<").length, 1);
+    EXPECT_EQ(custom.longest_match("<<<<").length, 3);
+}
+
+TEST_F(lexical_analyzer_test, runtime_symbol_starts) {
+    // Symbols beginning with characters that are neither punctuation nor
+    // identifier characters.
+    rebar::symbol_map symbols = rebar::default_symbol_map();
+    symbols.emplace("\xC2\xB1", std::pair{ rebar::symbol::plus, false });
+    symbols.emplace("'", std::pair{ rebar::symbol::tilda, false });
+
+    rebar::lexical_analyzer const analyzer(m_string_engine, symbols);
+
+    EXPECT_TRUE(rebar::symbol_trie(symbols).starts_symbol(0xC2));
+    EXPECT_FALSE(rebar::default_symbol_trie().starts_symbol(0xC2));
+
+    rebar::lexical_unit unit(std::string("a \xC2\xB1 'b 1'000"));
+    analyzer.perform_analysis(unit);
+
+    std::vector<rebar::token> const expected{
+        rebar::token(m_string_engine.str("a"), rebar::token_type::identifier),
+        rebar::token(rebar::symbol::plus),
+        rebar::token(rebar::symbol::tilda),
+        rebar::token(m_string_engine.str("b"), rebar::token_type::identifier),
+        rebar::token(rebar::integer(1000)),
+    };
+
+    EXPECT_EQ(unit.tokens(), expected);
+
+    // Without them, the characters are not recognized.
+    rebar::lexical_unit unrecognized(std::string("a \xC2\xB1 b"));
+    EXPECT_THROW(m_lexical_analyzer.perform_analysis(unrecognized), std::invalid_argument);
+}
+
+namespace {
+
+    constexpr std::array<rebar::symbol_definition, 4> arrow_symbols{{
+        { "-",     rebar::symbol::minus,         false },
+        { "->",    rebar::symbol::carrot_right,  false },
+        { "-->",   rebar::symbol::double_minus,  false },
+        { "never", rebar::symbol::boolean_false, true  },
+    }};
+
+}
+
+TEST_F(lexical_analyzer_test, static_symbol_trie) {
+    // The default trie is generated entirely at compile time.
+    constexpr auto const & tables = rebar::static_symbol_trie_tables_v<rebar::default_symbols>;
+
+    static_assert(tables.nodes[0].edges_count == 29);
+    static_assert(tables.root_edges['t'] != 0 && tables.root_edges['a'] == 0);
+
+    rebar::symbol_trie const trie(tables);
+
+    EXPECT_EQ(trie.longest_match("&&=").value, rebar::symbol::double_ampersand_equals);
+    EXPECT_EQ(trie.longest_match("||x").length, 2);
+    EXPECT_EQ(trie.longest_match("tru").length, 0);
+
+    // Compile-time and runtime tries agree on every symbol.
+    rebar::symbol_trie const runtime_trie(rebar::default_symbol_map());
+
+    EXPECT_EQ(trie.node_count(), runtime_trie.node_count());
+
+    for (auto const & definition : rebar::default_symbols) {
+        auto const match = trie.longest_match(definition.text);
+
+        EXPECT_EQ(match.length, definition.text.size());
+        EXPECT_EQ(match.value, definition.value);
+        EXPECT_EQ(runtime_trie.longest_match(definition.text).value, definition.value);
+    }
+
+    // Custom compile-time symbol sets drive the analyzer.
+    rebar::lexical_analyzer const analyzer(
+        m_string_engine,
+        rebar::symbol_trie(rebar::static_symbol_trie_tables_v<arrow_symbols>)
+    );
+
+    rebar::lexical_unit lu("a->b-->never-nevermore");
+    analyzer.perform_analysis(lu);
+
+    auto const tokens = lu.tokens();
+
+    ASSERT_EQ(tokens.size(), 7);
+    EXPECT_EQ(tokens[1].get_symbol(), rebar::symbol::carrot_right);
+    EXPECT_EQ(tokens[3].get_symbol(), rebar::symbol::double_minus);
+    EXPECT_EQ(tokens[4].get_symbol(), rebar::symbol::boolean_false);
+    EXPECT_EQ(tokens[5].get_symbol(), rebar::symbol::minus);
+    EXPECT_TRUE(tokens[6].is_identifier());
+    EXPECT_EQ(tokens[6].get_string().view(), "nevermore");
+}
+
+TEST_F(lexical_analyzer_test, token_storage) {
+    rebar::lexical_unit lu("name = \"text\" + 42;");
+    m_lexical_analyzer.perform_analysis(lu);
+
+    ASSERT_EQ(lu.token_count(), 6);
+    ASSERT_EQ(lu.token_types().size(), 6);
+    ASSERT_EQ(lu.token_payloads().size(), 6);
+    ASSERT_EQ(lu.token_positions().size(), 6);
+
+    EXPECT_EQ(lu.token_types()[0], rebar::token_type::identifier);
+    EXPECT_EQ(lu.token_types()[1], rebar::token_type::symbol);
+    EXPECT_EQ(lu.token_types()[2], rebar::token_type::string);
+    EXPECT_EQ(lu.token_types()[4], rebar::token_type::integer);
+
+    EXPECT_EQ(lu.token_payloads()[1].symbol_value, rebar::symbol::equals);
+    EXPECT_EQ(lu.token_payloads()[3].symbol_value, rebar::symbol::plus);
+    EXPECT_EQ(lu.token_payloads()[4].integer_value, 42);
+    EXPECT_EQ(lu.token_payloads()[5].symbol_value, rebar::symbol::semicolon);
+
+    EXPECT_EQ(lu.token_positions()[0], 0);
+    EXPECT_EQ(lu.token_positions()[2], 7);
+    EXPECT_EQ(lu.token_positions()[4], 16);
+
+    // Materialized tokens refer to the same strings as the unit.
+    auto const tokens = lu.tokens();
+
+    ASSERT_EQ(tokens.size(), lu.token_count());
+    EXPECT_EQ(tokens[0].get_string().view(), "name");
+    EXPECT_EQ(lu.token_at(2).get_string(), tokens[2].get_string());
+    EXPECT_EQ(lu.token_at(2).get_string().view(), "text");
+    EXPECT_EQ(lu.token_at(4).get_integer(), 42);
+    EXPECT_TRUE(lu.token_at(5) == rebar::symbol::semicolon);
+}
+
+TEST_F(lexical_analyzer_test, compact_tokens) {
+    static_assert(sizeof(rebar::token) == 16);
+
+    auto const base_references = [this] {
+        return m_string_engine.str("token_text").reference()->reference_count;
+    };
+
+    auto const initial = base_references();
+
+    {
+        rebar::token const original(m_string_engine.str("token_text"), rebar::token_type::identifier);
+        EXPECT_EQ(base_references(), initial + 1);
+
+        // Copies hold their own reference; moves transfer it.
+        rebar::token copy(original);
+        EXPECT_EQ(base_references(), initial + 2);
+
+        rebar::token moved(std::move(copy));
+        EXPECT_EQ(base_references(), initial + 2);
+        EXPECT_TRUE(moved.is_identifier());
+        EXPECT_EQ(moved.get_string().view(), "token_text");
+        EXPECT_EQ(moved, original);
+
+        // Assigning over a string token releases its reference.
+        moved = rebar::token(rebar::symbol::plus);
+        EXPECT_EQ(base_references(), initial + 1);
+        EXPECT_TRUE(moved == rebar::symbol::plus);
+
+        moved = original;
+        EXPECT_EQ(base_references(), initial + 2);
+    }
+
+    EXPECT_EQ(base_references(), initial);
+
+    rebar::token integer_token(rebar::integer(42));
+    rebar::token const number_token(0.5);
+
+    EXPECT_EQ(integer_token.get_integer(), 42);
+    EXPECT_EQ(number_token.get_number(), 0.5);
+
+    integer_token = number_token;
+    EXPECT_TRUE(integer_token.is_number());
+    EXPECT_EQ(integer_token, number_token);
+}
+
+TEST_F(lexical_analyzer_test, loaded_plaintext) {
+    std::string const plaintext = "value = \"text\" + 1'000;";
+
+    rebar::lexical_unit owned(plaintext);
+    m_lexical_analyzer.perform_analysis(owned);
+
+    // Borrowed plaintext is analyzed in place.
+    auto borrowed = rebar::lexical_unit::load(plaintext);
+    EXPECT_EQ(borrowed.plaintext().data(), plaintext.data());
+
+    m_lexical_analyzer.perform_analysis(borrowed);
+    EXPECT_EQ(borrowed.tokens(), owned.tokens());
+
+    auto const path = std::filesystem::temp_directory_path() / "rebar_lexical_unit_test.rbr";
+
+    {
+        std::ofstream(path, std::ios::binary) << plaintext;
+
+        auto mapped = rebar::lexical_unit::load_file(path);
+        EXPECT_EQ(mapped.plaintext(), plaintext);
+
+        m_lexical_analyzer.perform_analysis(mapped);
+        EXPECT_EQ(mapped.tokens(), owned.tokens());
+        EXPECT_EQ(std::vector(mapped.token_positions().begin(), mapped.token_positions().end()), std::vector(owned.token_positions().begin(), owned.token_positions().end()));
+    }
+
+    {
+        std::ofstream(path, std::ios::binary).flush();
+
+        auto empty = rebar::lexical_unit::load_file(path);
+        m_lexical_analyzer.perform_analysis(empty);
+        EXPECT_EQ(empty.token_count(), 0);
+    }
+
+    // Files too large for 32-bit token positions are rejected before
+    // mapping. (The file is sparse, so nothing is written.)
+    {
+        std::ofstream(path, std::ios::binary).flush();
+        std::filesystem::resize_file(path, rebar::lexical_unit::max_plaintext_size + 1);
+
+        EXPECT_THROW(static_cast<void>(rebar::lexical_unit::load_file(path)), std::length_error);
+    }
+
+    EXPECT_NO_THROW(rebar::lexical_unit::check_plaintext_size(rebar::lexical_unit::max_plaintext_size));
+    EXPECT_THROW(rebar::lexical_unit::check_plaintext_size(rebar::lexical_unit::max_plaintext_size + 1), std::length_error);
+
+    std::filesystem::remove(path);
+
+    EXPECT_THROW(static_cast<void>(rebar::lexical_unit::load_file(path)), std::runtime_error);
+}
+
+TEST_F(lexical_analyzer_test, parallel_analysis) {
+    // Multi-line string literals make chunks begin inside them, and their
+    // contents would not lex (or would overflow) outside of a string.
+    std::string plaintext;
+
+    for (std::size_t i = 0; plaintext.size() < (4 << 20); ++i) {
+        if (i % 7 == 0) {
+            plaintext += fmt::format("text_{} = \"first line\n99999999999999999999999 \\\" still inside\n-.5\";\n", i);
+        } else if (i % 11 == 0) {
+            // Defeats the guess of whether a chunk begins in a string.
+            plaintext += fmt::format("fooled_{} = \"first line\nsecond \\\\\" + \"@ 99999999999999999999999 \xC3\xA9\n\";\n", i);
+        } else {
+            plaintext += fmt::format("value_{} = value_{} * {} + 1'000.25; // if (true) {{ return; }}\n", i, i / 3, i % 977);
+        }
+    }
+
+    rebar::lexical_unit sequential(plaintext);
+    m_lexical_analyzer.perform_analysis(sequential);
+
+    auto const expected = sequential.tokens();
+
+    for (std::size_t const thread_count : { 1, 2, 3, 8, 13 }) {
+        rebar::lexical_unit parallel(plaintext);
+        m_lexical_analyzer.perform_parallel_analysis(parallel, thread_count);
+
+        ASSERT_EQ(parallel.token_count(), sequential.token_count()) << "Threads: " << thread_count << '.';
+        EXPECT_TRUE(std::ranges::equal(parallel.token_positions(), sequential.token_positions())) << "Threads: " << thread_count << '.';
+        EXPECT_EQ(parallel.tokens(), expected) << "Threads: " << thread_count << '.';
+    }
+
+    // Unrecognized characters are reported rather than analyzed forever.
+    rebar::lexical_unit unexpected("value = 1 \x01 2;");
+    EXPECT_THROW(m_lexical_analyzer.perform_parallel_analysis(unexpected), std::invalid_argument);
+
+    // Genuine errors are still raised.
+    rebar::lexical_unit invalid(plaintext + "99999999999999999999999;");
+    EXPECT_THROW(m_lexical_analyzer.perform_parallel_analysis(invalid, 4), std::out_of_range);
+}
+
+TEST_F(lexical_analyzer_test, incremental_analysis) {
+    // Applies an edit incrementally, and compares against analysis of the
+    // edited plaintext from scratch.
+    auto const expect_edit = [this](rebar::lexical_unit & a_unit, std::size_t const a_offset, std::size_t const a_removed_length, std::string_view const a_inserted_text) {
+        std::string edited(a_unit.plaintext());
+        edited.replace(a_offset, a_removed_length, a_inserted_text);
+
+        m_lexical_analyzer.perform_incremental_analysis(a_unit, a_offset, a_removed_length, a_inserted_text);
+
+        rebar::lexical_unit expected(edited);
+        m_lexical_analyzer.perform_analysis(expected);
+
+        ASSERT_EQ(a_unit.plaintext(), edited);
+        ASSERT_EQ(a_unit.token_count(), expected.token_count()) << "Edit at " << a_offset << '.';
+        EXPECT_TRUE(std::ranges::equal(a_unit.token_positions(), expected.token_positions())) << "Edit at " << a_offset << '.';
+        EXPECT_EQ(a_unit.tokens(), expected.tokens()) << "Edit at " << a_offset << '.';
+    };
+
+    rebar::lexical_unit unit(std::string("local value = first + 2;\nif (value >= 3) { text = \"a b\"; }\n"));
+    m_lexical_analyzer.perform_analysis(unit);
+
+    // Symbols split by the edit (">=" to "> =", and back).
+    expect_edit(unit, 36, 0, " ");
+    expect_edit(unit, 36, 1, "");
+
+    // A keyword becoming an identifier.
+    expect_edit(unit, 27, 0, "x");
+    expect_edit(unit, 27, 1, "");
+
+    // Opening a string swallowing the remainder, and closing it again.
+    expect_edit(unit, 14, 0, "\"");
+    expect_edit(unit, 14, 1, "");
+
+    // Numbers extended by the edit, and edits at the boundaries.
+    expect_edit(unit, 23, 0, ".5");
+    expect_edit(unit, 0, 0, "first_");
+    expect_edit(unit, unit.plaintext().size(), 0, " tail");
+    expect_edit(unit, 0, unit.plaintext().size(), "");
+    expect_edit(unit, 0, 0, "value = 1;");
+
+    EXPECT_THROW(m_lexical_analyzer.perform_incremental_analysis(unit, 4, 100, ""), std::out_of_range);
+
+    // Edits before the first token, including inside leading whitespace.
+    rebar::lexical_unit leading(std::string("   x"));
+    m_lexical_analyzer.perform_analysis(leading);
+    expect_edit(leading, 0, 0, "y");
+    expect_edit(leading, 2, 0, "z ");
+
+    rebar::lexical_unit indented(std::string("          x"));
+    m_lexical_analyzer.perform_analysis(indented);
+    expect_edit(indented, 5, 0, "y");
+    expect_edit(indented, 8, 1, "= ");
+
+    // Random edits of a larger plaintext.
+    std::string plaintext;
+
+    for (std::size_t i = 0; i < 200; ++i) {
+        plaintext += fmt::format("value_{} = value_{} * {} + 1'000.25; text = \"line {}\";\n", i, i / 3, i % 977, i);
+    }
+
+    rebar::lexical_unit large(plaintext);
+    m_lexical_analyzer.perform_analysis(large);
+
+    constexpr std::array fragments{ "", " ", "\"", "-", ".", "=", "5", "if", "x", ";\n", "= value \"" };
+    std::mt19937 engine(49);
+
+    for (std::size_t i = 0; i < 500; ++i) {
+        auto const size = large.plaintext().size();
+        auto const offset = std::uniform_int_distribution<std::size_t>(0, size)(engine);
+        auto const removed_length = std::uniform_int_distribution<std::size_t>(0, std::min<std::size_t>(size - offset, 4))(engine);
+        auto const inserted_text = fragments[std::uniform_int_distribution<std::size_t>(0, fragments.size() - 1)(engine)];
+
+        std::string edited(large.plaintext());
+        edited.replace(offset, removed_length, inserted_text);
+
+        // Skip edits producing plaintexts that fail analysis (such as
+        // unterminated escape sequences).
+        try {
+            rebar::lexical_unit probe(edited);
+            m_lexical_analyzer.perform_analysis(probe);
+        } catch (std::exception const &) {
+            EXPECT_ANY_THROW(m_lexical_analyzer.perform_incremental_analysis(large, offset, removed_length, inserted_text));
+            EXPECT_NE(large.plaintext(), edited);
+            continue;
+        }
+
+        expect_edit(large, offset, removed_length, inserted_text);
+
+        if (testing::Test::HasFailure()) {
+            break;
+        }
+    }
+}
+
+TEST_F(lexical_analyzer_test, plaintext_locations) {
+    rebar::lexical_unit unit(std::string("first = 1;\n\n  second = \"two\nlines\";\r\nthird"));
+    m_lexical_analyzer.perform_analysis(unit);
+
+    EXPECT_EQ(unit.line_count(), 5);
+
+    EXPECT_EQ(unit.location_of(0), (rebar::plaintext_location{ 1, 1 }));
+    EXPECT_EQ(unit.location_of(10), (rebar::plaintext_location{ 1, 11 }));
+    EXPECT_EQ(unit.location_of(11), (rebar::plaintext_location{ 2, 1 }));
+    EXPECT_EQ(unit.location_of(unit.plaintext().size()), (rebar::plaintext_location{ 5, 6 }));
+    EXPECT_THROW(static_cast<void>(unit.location_of(unit.plaintext().size() + 1)), std::out_of_range);
+
+    EXPECT_EQ(unit.token_location(0), (rebar::plaintext_location{ 1, 1 }));
+    EXPECT_EQ(unit.token_location(4), (rebar::plaintext_location{ 3, 3 }));
+    EXPECT_EQ(unit.token_location(6), (rebar::plaintext_location{ 3, 12 }));
+    EXPECT_EQ(unit.token_location(unit.token_count() - 1), (rebar::plaintext_location{ 5, 1 }));
+
+    // Agrees with counting line feeds from the beginning, and follows edits.
+    m_lexical_analyzer.perform_incremental_analysis(unit, 0, 0, "\n\nzeroth;");
+
+    for (std::size_t i = 0; i < unit.token_count(); ++i) {
+        auto const preceding = unit.plaintext().substr(0, unit.token_positions()[i]);
+        auto const line_begin = preceding.rfind('\n');
+
+        rebar::plaintext_location const expected{
+            static_cast<std::size_t>(std::ranges::count(preceding, '\n')) + 1,
+            preceding.size() - (line_begin == std::string_view::npos ? 0 : line_begin + 1) + 1,
+        };
+
+        EXPECT_EQ(unit.token_location(i), expected) << "Token " << i << '.';
+    }
+
+    EXPECT_EQ(rebar::lexical_unit::load({}).line_count(), 1);
+}
+
 // TODO: Add more lexical analyzer tests (more symbols, literal combinations).
\ No newline at end of file
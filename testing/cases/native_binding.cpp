@@ -0,0 +1,115 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <rebar/environment/environment.hpp>
+#include <rebar/environment/native.hpp>
+
+namespace {
+
+    rebar::integer add(rebar::integer const a_lhs, rebar::integer const a_rhs) {
+        return a_lhs + a_rhs;
+    }
+
+    double scale(double const a_value, float const a_factor) noexcept {
+        return a_value * a_factor;
+    }
+
+    std::size_t length(std::string_view const a_string) {
+        return a_string.size();
+    }
+
+    std::string greet(std::string_view const a_name) {
+        return "Hello, " + std::string(a_name) + "!";
+    }
+
+    struct vector2 {
+        double x;
+        double y;
+
+        [[nodiscard]]
+        double dot(vector2 const & a_vector) const noexcept {
+            return x * a_vector.x + y * a_vector.y;
+        }
+
+        void scale(double const a_factor) noexcept {
+            x *= a_factor;
+            y *= a_factor;
+        }
+    };
+
+    vector2 make_vector2(double const a_x, double const a_y) {
+        return { a_x, a_y };
+    }
+
+}
+
+class native_binding_test : public testing::Test {
+protected:
+    rebar::environment m_environment;
+};
+
+TEST_F(native_binding_test, function_arguments_and_results) {
+    m_environment.bind("add", &add);
+    m_environment.bind<&scale>("scale");
+    m_environment.bind("length", &length);
+    m_environment.bind("greet", &greet);
+
+    auto const add_result = m_environment.global("add").call({ rebar::object(40), rebar::object(2) });
+    ASSERT_TRUE(add_result.is_integer());
+    EXPECT_EQ(add_result.get_integer(), 42);
+
+    // Integers are accepted for floating point parameters.
+    auto const scale_result = m_environment.global("scale").call({ rebar::object(3), rebar::object(0.5) });
+    ASSERT_TRUE(scale_result.is_number());
+    EXPECT_EQ(scale_result.get_number(), 1.5);
+
+    auto const length_result = m_environment.global("length").call({ rebar::object(m_environment.str("four")) });
+    ASSERT_TRUE(length_result.is_integer());
+    EXPECT_EQ(length_result.get_integer(), 4);
+
+    auto const greet_result = m_environment.global("greet").call({ rebar::object(m_environment.str("world")) });
+    ASSERT_TRUE(greet_result.is_string());
+    EXPECT_EQ(greet_result.string_view(), "Hello, world!");
+}
+
+TEST_F(native_binding_test, argument_checking) {
+    auto const add_function = m_environment.function(&add);
+
+    EXPECT_THROW(std::ignore = add_function.call({ rebar::object(1) }), std::invalid_argument);
+    EXPECT_THROW(std::ignore = add_function.call({ rebar::object(1), rebar::object(1.0) }), std::invalid_argument);
+}
+
+TEST_F(native_binding_test, native_types) {
+    m_environment.bind("make_vector2", &make_vector2);
+    m_environment.bind<&vector2::dot>("dot");
+    m_environment.bind("scale", &vector2::scale);
+
+    auto const vector = m_environment.global("make_vector2").call({ rebar::object(1.0), rebar::object(2.0) });
+    ASSERT_TRUE(vector.is_native());
+    ASSERT_NE(rebar::native_cast<vector2>(vector), nullptr);
+    EXPECT_EQ(rebar::native_cast<int>(vector), nullptr);
+
+    // Member functions modify the native value in place.
+    std::ignore = m_environment.global("scale").call({ vector, rebar::object(2) });
+    EXPECT_EQ(rebar::native_cast<vector2>(vector)->x, 2.0);
+
+    auto const dot_result = m_environment.global("dot").call({ vector, vector });
+    ASSERT_TRUE(dot_result.is_number());
+    EXPECT_EQ(dot_result.get_number(), 20.0);
+
+    EXPECT_THROW(std::ignore = m_environment.global("dot").call({ vector, rebar::object(1) }), std::invalid_argument);
+}
+
+TEST_F(native_binding_test, payload_lifetime) {
+    {
+        auto const function = m_environment.function(&add);
+        auto const native = m_environment.native(vector2{ 1.0, 2.0 });
+
+        EXPECT_GT(m_environment.allocator_statistics().used_bytes(), 0);
+    }
+
+    EXPECT_EQ(m_environment.allocator_statistics().used_bytes(), 0);
+}
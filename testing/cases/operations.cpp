@@ -0,0 +1,146 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <rebar/environment/environment.hpp>
+#include <rebar/environment/operations.hpp>
+
+class operations_test : public testing::Test {
+protected:
+    rebar::environment env;
+};
+
+TEST_F(operations_test, integer_arithmetic) {
+    using enum rebar::operation;
+
+    rebar::object const lhs(rebar::integer(17));
+    rebar::object const rhs(rebar::integer(5));
+
+    EXPECT_EQ(rebar::perform_operation<addition>(lhs, rhs).get_integer(), 22);
+    EXPECT_EQ(rebar::perform_operation<subtraction>(lhs, rhs).get_integer(), 12);
+    EXPECT_EQ(rebar::perform_operation<multiplication>(lhs, rhs).get_integer(), 85);
+    EXPECT_EQ(rebar::perform_operation<modulo>(lhs, rhs).get_integer(), 2);
+    EXPECT_EQ(rebar::perform_operation<exponentiation>(lhs, rhs).get_integer(), 1419857);
+    EXPECT_EQ(rebar::perform_operation<bitwise_xor>(lhs, rhs).get_integer(), 17 ^ 5);
+
+    auto const quotient = rebar::perform_operation<division>(lhs, rhs);
+    ASSERT_TRUE(quotient.is_number());
+    EXPECT_DOUBLE_EQ(quotient.get_number(), 3.4);
+
+    // The runtime entry point agrees with the inline fast paths.
+    EXPECT_EQ(rebar::perform_operation(addition, lhs, rhs).get_integer(), 22);
+
+    EXPECT_THROW(static_cast<void>(rebar::perform_operation<modulo>(lhs, rebar::object(rebar::integer(0)))), std::domain_error);
+}
+
+TEST_F(operations_test, integer_overflow_promotion) {
+    using enum rebar::operation;
+
+    rebar::object const max(std::numeric_limits<rebar::integer>::max());
+    rebar::object const min(std::numeric_limits<rebar::integer>::min());
+    rebar::object const one(rebar::integer(1));
+
+    auto const sum = rebar::perform_operation<addition>(max, one);
+    ASSERT_TRUE(sum.is_number());
+    EXPECT_DOUBLE_EQ(sum.get_number(), static_cast<double>(std::numeric_limits<rebar::integer>::max()) + 1.0);
+
+    auto const difference = rebar::perform_operation<subtraction>(min, one);
+    EXPECT_TRUE(difference.is_number());
+
+    auto const product = rebar::perform_operation<multiplication>(max, max);
+    EXPECT_TRUE(product.is_number());
+
+    auto const power = rebar::perform_operation<exponentiation>(rebar::object(rebar::integer(2)), rebar::object(rebar::integer(64)));
+    ASSERT_TRUE(power.is_number());
+    EXPECT_DOUBLE_EQ(power.get_number(), std::pow(2.0, 64.0));
+
+    EXPECT_EQ(rebar::perform_operation<modulo>(min, rebar::object(rebar::integer(-1))).get_integer(), 0);
+}
+
+TEST_F(operations_test, mixed_numeric_operands) {
+    using enum rebar::operation;
+
+    rebar::object const integer(rebar::integer(3));
+    rebar::object const number(0.5);
+
+    auto const sum = rebar::perform_operation<addition>(integer, number);
+    ASSERT_TRUE(sum.is_number());
+    EXPECT_DOUBLE_EQ(sum.get_number(), 3.5);
+
+    EXPECT_DOUBLE_EQ(rebar::perform_operation<exponentiation>(rebar::object(4.0), number).get_number(), 2.0);
+    EXPECT_DOUBLE_EQ(rebar::perform_operation<modulo>(rebar::object(5.5), rebar::object(rebar::integer(2))).get_number(), 1.5);
+
+    EXPECT_EQ(rebar::perform_operation<equality>(rebar::object(rebar::integer(2)), rebar::object(2.0)).get_boolean(), rebar::_true);
+    EXPECT_EQ(rebar::perform_operation<lesser>(number, integer).get_boolean(), rebar::_true);
+    EXPECT_EQ(rebar::perform_operation<greater_equality>(number, integer).get_boolean(), rebar::_false);
+
+    // 2^53 + 1 rounds to 2^53 as a number, but must still compare exactly.
+    rebar::object const odd(rebar::integer(9007199254740993));
+    rebar::object const even(9007199254740992.0);
+
+    EXPECT_EQ(rebar::perform_operation(equality, odd, even).get_boolean(), rebar::_false);
+    EXPECT_EQ(rebar::perform_operation(equality, even, odd).get_boolean(), rebar::_false);
+    EXPECT_EQ(rebar::perform_operation(equality, odd, even).get_boolean() == rebar::_true, odd.equals(even));
+    EXPECT_EQ(rebar::perform_operation(greater, odd, even).get_boolean(), rebar::_true);
+    EXPECT_EQ(rebar::perform_operation(lesser_equality, odd, even).get_boolean(), rebar::_false);
+    EXPECT_EQ(rebar::perform_operation(lesser, even, odd).get_boolean(), rebar::_true);
+    EXPECT_EQ(rebar::perform_operation(greater_equality, even, odd).get_boolean(), rebar::_false);
+
+    EXPECT_EQ(rebar::perform_operation(equality, even, rebar::object(rebar::integer(9007199254740992))).get_boolean(), rebar::_true);
+    EXPECT_EQ(rebar::perform_operation(lesser, odd, rebar::object(9007199254740994.0)).get_boolean(), rebar::_true);
+    EXPECT_EQ(rebar::perform_operation(lesser, rebar::object(rebar::integer(-3)), rebar::object(-2.5)).get_boolean(), rebar::_true);
+    EXPECT_EQ(rebar::perform_operation(greater, rebar::object(rebar::integer(-2)), rebar::object(-2.5)).get_boolean(), rebar::_true);
+
+    // Numbers beyond the integer range, and NaN, order without overflow.
+    rebar::object const max(std::numeric_limits<rebar::integer>::max());
+    EXPECT_EQ(rebar::perform_operation(lesser, max, rebar::object(9223372036854775808.0)).get_boolean(), rebar::_true);
+    EXPECT_EQ(rebar::perform_operation(equality, max, rebar::object(9223372036854775808.0)).get_boolean(), rebar::_false);
+    EXPECT_EQ(rebar::perform_operation(greater_equality, integer, rebar::object(std::nan(""))).get_boolean(), rebar::_false);
+    EXPECT_EQ(rebar::perform_operation(lesser, rebar::object(std::nan("")), integer).get_boolean(), rebar::_false);
+}
+
+TEST_F(operations_test, strings) {
+    using enum rebar::operation;
+
+    rebar::object const hello(env.str("hello, "));
+    rebar::object const world(env.str("world"));
+
+    auto const concatenated = rebar::perform_operation<addition>(hello, world);
+    ASSERT_TRUE(concatenated.is_string());
+    EXPECT_EQ(concatenated.string_view(), "hello, world");
+
+    // Concatenation results are interned like every other string.
+    rebar::object const expected(env.str("hello, world"));
+    EXPECT_EQ(rebar::perform_operation<equality>(concatenated, expected).get_boolean(), rebar::_true);
+    EXPECT_EQ(rebar::perform_operation<equality>(hello, world).get_boolean(), rebar::_false);
+
+    EXPECT_EQ(rebar::perform_operation<lesser>(hello, world).get_boolean(), rebar::_true);
+    EXPECT_EQ(rebar::perform_operation<greater>(hello, world).get_boolean(), rebar::_false);
+}
+
+TEST_F(operations_test, equality_and_undefined_pairs) {
+    using enum rebar::operation;
+
+    rebar::object const null_object;
+    rebar::object const truth(rebar::_true);
+    rebar::object const array = env.array();
+
+    EXPECT_EQ(rebar::perform_operation<equality>(null_object, null_object).get_boolean(), rebar::_true);
+    EXPECT_EQ(rebar::perform_operation<equality>(null_object, truth).get_boolean(), rebar::_false);
+    EXPECT_EQ(rebar::perform_operation<equality>(array, array).get_boolean(), rebar::_true);
+    EXPECT_EQ(rebar::perform_operation<equality>(array, env.array()).get_boolean(), rebar::_true);
+
+    EXPECT_EQ(rebar::perform_operation<bitwise_and>(truth, rebar::object(rebar::_false)).get_boolean(), rebar::_false);
+    EXPECT_EQ(rebar::perform_operation<bitwise_or>(truth, rebar::object(rebar::_false)).get_boolean(), rebar::_true);
+
+    EXPECT_THROW(static_cast<void>(rebar::perform_operation<addition>(null_object, truth)), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(rebar::perform_operation<lesser>(array, array)), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(rebar::perform_operation<subtraction>(rebar::object(env.str("a")), rebar::object(rebar::integer(1)))), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(rebar::perform_operation(rebar::operation::assignment, null_object, null_object)), std::invalid_argument);
+}
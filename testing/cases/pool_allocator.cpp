@@ -0,0 +1,89 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <rebar/environment/array.hpp>
+#include <rebar/environment/environment.hpp>
+#include <rebar/memory/pool_allocator.hpp>
+
+class pool_allocator_test : public testing::Test {
+protected:
+    rebar::pool_allocator m_pool_allocator;
+};
+
+TEST_F(pool_allocator_test, size_classes) {
+    EXPECT_EQ(rebar::pool_allocator::size_class_index(1), 0);
+    EXPECT_EQ(rebar::pool_allocator::size_class_index(16), 0);
+    EXPECT_EQ(rebar::pool_allocator::size_class_index(17), 1);
+    EXPECT_EQ(rebar::pool_allocator::size_class_index(40), 2);
+    EXPECT_EQ(rebar::pool_allocator::size_class_index(256), rebar::pool_size_class_count - 1);
+    EXPECT_EQ(rebar::pool_allocator::size_class_index(257), rebar::pool_size_class_count);
+}
+
+TEST_F(pool_allocator_test, block_reuse) {
+    void * const first = m_pool_allocator.allocate(40);
+    m_pool_allocator.deallocate(first, 40);
+
+    // The most recently freed block of a class is handed out first.
+    void * const second = m_pool_allocator.allocate(48);
+    EXPECT_EQ(first, second);
+
+    m_pool_allocator.deallocate(second, 48);
+}
+
+TEST_F(pool_allocator_test, statistics) {
+    std::vector<void *> blocks;
+
+    for (std::size_t i = 0; i < 1000; ++i) {
+        blocks.push_back(m_pool_allocator.allocate(64));
+    }
+
+    auto statistics = m_pool_allocator.statistics();
+    auto const & class_statistics = statistics.classes[rebar::pool_allocator::size_class_index(64)];
+
+    EXPECT_EQ(class_statistics.block_size, 64);
+    EXPECT_EQ(class_statistics.used_blocks, 1000);
+    EXPECT_EQ(class_statistics.total_allocations, 1000);
+    EXPECT_GE(class_statistics.reserved_blocks, 1000);
+    EXPECT_EQ(statistics.used_bytes(), 64'000);
+
+    for (void * const block : blocks) {
+        m_pool_allocator.deallocate(block, 64);
+    }
+
+    statistics = m_pool_allocator.statistics();
+
+    EXPECT_EQ(statistics.classes[rebar::pool_allocator::size_class_index(64)].used_blocks, 0);
+
+    // Oversized requests bypass the pool.
+    void * const oversized = m_pool_allocator.allocate(1024);
+    EXPECT_EQ(m_pool_allocator.statistics().oversized_used, 1);
+
+    m_pool_allocator.deallocate(oversized, 1024);
+    EXPECT_EQ(m_pool_allocator.statistics().oversized_used, 0);
+}
+
+TEST_F(pool_allocator_test, environment_array_payloads) {
+    rebar::environment env;
+
+    auto const array_block_size = rebar::pool_size_classes[rebar::pool_allocator::size_class_index(sizeof(rebar::internal_array))];
+
+    {
+        auto outer = env.array();
+        outer.array_push(env.array(4));
+        outer.array_push(rebar::object(42));
+
+        EXPECT_EQ(env.allocator_statistics().used_bytes(), 2 * array_block_size);
+        EXPECT_EQ(outer.array_length(), 2);
+        EXPECT_TRUE(outer.array_at(0).is_array());
+        EXPECT_TRUE(outer.array_at(1).is_integer());
+
+        // Overwriting an element releases the previous payload.
+        outer.array_set(0, rebar::object(7));
+        EXPECT_EQ(env.allocator_statistics().used_bytes(), array_block_size);
+    }
+
+    EXPECT_EQ(env.allocator_statistics().used_bytes(), 0);
+}
@@ -0,0 +1,215 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <rebar/environment/array.hpp>
+#include <rebar/environment/environment.hpp>
+#include <rebar/environment/frozen.hpp>
+#include <rebar/environment/serialization.hpp>
+
+namespace {
+
+    rebar::integer identity(rebar::integer const a_value) {
+        return a_value;
+    }
+
+    bool within(std::vector<std::byte> const & a_data, void const * const a_pointer) {
+        auto const * const pointer = static_cast<std::byte const *>(a_pointer);
+        return pointer >= a_data.data() && pointer < a_data.data() + a_data.size();
+    }
+
+}
+
+class serialization_test : public testing::Test {
+protected:
+    rebar::environment env;
+
+    /// Builds { names = ["alpha", "beta", "alpha"], samples = [0.5, 1.5], ids = [1, 2, 3], mixed = [1, "one", null, { alpha = true }] }.
+    rebar::object make_graph() {
+        auto names = env.array();
+        names.array_push(rebar::object(env.str("alpha")));
+        names.array_push(rebar::object(env.str("beta")));
+        names.array_push(rebar::object(env.str("alpha")));
+
+        auto samples = env.array();
+        samples.array_push(rebar::object(0.5));
+        samples.array_push(rebar::object(1.5));
+
+        auto ids = env.array();
+
+        for (rebar::integer i = 1; i <= 3; ++i) {
+            ids.array_push(rebar::object(i));
+        }
+
+        auto flags = env.table();
+        flags.table_set(rebar::object(env.str("alpha")), rebar::object(rebar::_true));
+
+        auto mixed = env.array();
+        mixed.array_push(rebar::object(rebar::integer(1)));
+        mixed.array_push(rebar::object(env.str("one")));
+        mixed.array_push(rebar::object());
+        mixed.array_push(flags);
+
+        auto graph = env.table();
+        graph.table_set(rebar::object(env.str("names")), names);
+        graph.table_set(rebar::object(env.str("samples")), samples);
+        graph.table_set(rebar::object(env.str("ids")), ids);
+        graph.table_set(rebar::object(env.str("mixed")), mixed);
+
+        return graph;
+    }
+};
+
+TEST_F(serialization_test, round_trip) {
+    auto const source = make_graph();
+    auto const data = rebar::serialize_graph(source);
+    auto const graph = rebar::frozen_graph::load(data);
+
+    auto const & root = graph.root();
+
+    EXPECT_TRUE(root.is_frozen());
+    EXPECT_TRUE(root.equals(source));
+    EXPECT_EQ(root.hash(), source.hash());
+
+    auto const ids = root.table_get(rebar::object(env.str("ids")));
+    ASSERT_EQ(ids.array_length(), 3);
+    EXPECT_EQ(ids.array_at(2).get_integer(), 3);
+    EXPECT_THROW(static_cast<void>(ids.array_at(3)), std::out_of_range);
+
+    auto const samples = root.table_get(rebar::object(env.str("samples")));
+    EXPECT_DOUBLE_EQ(samples.array_at(1).get_number(), 1.5);
+}
+
+TEST_F(serialization_test, cached_hashes) {
+    auto const source = make_graph();
+    auto const data = rebar::serialize_graph(source);
+    auto const graph = rebar::frozen_graph::load(data);
+
+    // Hashes are computed as the graph is loaded, as for frozen graphs.
+    auto const & root = graph.root();
+    EXPECT_TRUE(root.hash_memoized());
+    EXPECT_TRUE(root.table_get(rebar::object(env.str("names"))).hash_memoized());
+    EXPECT_TRUE(root.table_get(rebar::object(env.str("ids"))).hash_memoized());
+    EXPECT_TRUE(root.table_get(rebar::object(env.str("mixed"))).array_at(3).hash_memoized());
+    EXPECT_EQ(root.hash(), source.hash());
+}
+
+TEST_F(serialization_test, zero_copy_views) {
+    auto const data = rebar::serialize_graph(make_graph());
+    auto const graph = rebar::frozen_graph::load(data);
+
+    auto const names = graph.root().table_get(rebar::object(env.str("names")));
+
+    // Strings view their characters in the serialized data, once per
+    // distinct string.
+    EXPECT_TRUE(within(data, names.array_at(0).string_view().data()));
+    EXPECT_EQ(names.array_at(0).string_view().data(), names.array_at(2).string_view().data());
+    EXPECT_EQ(names.array_at(1).string_view(), "beta");
+
+    // Mutating a loaded graph is not possible.
+    auto ids = graph.root().table_get(rebar::object(env.str("ids")));
+    EXPECT_THROW(ids.array_push(rebar::object(rebar::integer(4))), std::logic_error);
+}
+
+TEST_F(serialization_test, shared_shapes) {
+    auto rows = env.array();
+
+    for (rebar::integer i = 0; i < 100; ++i) {
+        auto row = env.table();
+        row.table_set(rebar::object(env.str("x")), rebar::object(i));
+        row.table_set(rebar::object(env.str("y")), rebar::object(-i));
+        rows.array_push(row);
+    }
+
+    auto const data = rebar::serialize_graph(rows);
+
+    // Each row is stored as an element, a node and two slots; the keys are
+    // stored once.
+    EXPECT_LT(data.size(), 100 * (16 + 16 + 2 * 16) + 1024);
+
+    auto const graph = rebar::frozen_graph::load(data);
+    EXPECT_TRUE(graph.root().equals(rows));
+    EXPECT_EQ(graph.root().array_at(42).table_get(rebar::object(env.str("y"))).get_integer(), -42);
+}
+
+TEST_F(serialization_test, mapped_file) {
+    auto const path = std::filesystem::temp_directory_path() / "rebar_serialization_test.rbg";
+    auto const source = make_graph();
+
+    rebar::write_graph(source, path);
+
+    {
+        auto const graph = rebar::frozen_graph::load_file(path);
+        EXPECT_TRUE(graph.root().equals(source));
+        EXPECT_EQ(graph.root().table_get(rebar::object(env.str("mixed"))).array_at(1).string_view(), "one");
+    }
+
+    std::filesystem::remove(path);
+
+    EXPECT_THROW(static_cast<void>(rebar::frozen_graph::load_file(path)), std::runtime_error);
+}
+
+TEST_F(serialization_test, invalid_graphs) {
+    auto holder = env.array();
+    holder.array_push(env.function<&identity>());
+    EXPECT_THROW(static_cast<void>(rebar::serialize_graph(holder)), std::invalid_argument);
+
+    auto data = rebar::serialize_graph(make_graph());
+
+    // Truncated data.
+    std::vector<std::byte> truncated(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(data.size() / 2));
+    EXPECT_THROW(static_cast<void>(rebar::frozen_graph::load(truncated)), std::runtime_error);
+
+    // Corrupted magic number.
+    data[0] = std::byte{ 0 };
+    EXPECT_THROW(static_cast<void>(rebar::frozen_graph::load(data)), std::runtime_error);
+}
+
+TEST_F(serialization_test, deep_nesting) {
+    // Hand-written, as building (and releasing) such a graph in an
+    // environment recurses too: each node is an array holding the previous
+    // one, laid out as a storage word, a length word and an encoded value.
+    constexpr std::uint64_t depth = 200'000;
+    constexpr std::uint64_t header_words = 7;
+    constexpr std::uint64_t node_words = 4;
+
+    auto const array_type = static_cast<std::uint64_t>(rebar::type::array);
+    auto const objects = static_cast<std::uint64_t>(rebar::array_storage::objects);
+
+    std::vector<std::uint64_t> words{
+        rebar::graph_magic | static_cast<std::uint64_t>(rebar::graph_format_version) << 32,
+        0, header_words * 8, // Strings.
+        0, header_words * 8, // Shapes.
+        array_type, (header_words + (depth - 1) * node_words) * 8, // Root.
+    };
+
+    for (std::uint64_t i = 0; i < depth; ++i) {
+        auto const previous = (header_words + (i - 1) * node_words) * 8;
+        words.insert(words.end(), { objects, static_cast<std::uint64_t>(i != 0), array_type, previous });
+    }
+
+    std::vector<std::byte> data(words.size() * sizeof(std::uint64_t));
+    std::memcpy(data.data(), words.data(), data.size());
+
+    auto const graph = rebar::frozen_graph::load(data);
+
+    std::uint64_t loaded_depth = 1;
+
+    for (auto node = graph.root(); node.array_length() != 0; node = node.array_at(0)) {
+        ++loaded_depth;
+    }
+
+    EXPECT_EQ(loaded_depth, depth);
+
+    // A node containing itself is still rejected.
+    words[header_words + (depth - 1) * node_words + 3] = words[6];
+    std::memcpy(data.data(), words.data(), data.size());
+
+    EXPECT_THROW(static_cast<void>(rebar::frozen_graph::load(data)), std::runtime_error);
+}
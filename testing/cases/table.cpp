@@ -0,0 +1,318 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <rebar/environment/environment.hpp>
+#include <rebar/environment/table.hpp>
+
+namespace {
+
+    struct point {
+        int x;
+        int y;
+
+        bool operator == (point const &) const = default;
+    };
+
+    struct handle {
+        int id;
+    };
+
+}
+
+class table_test : public testing::Test {
+protected:
+    rebar::environment env;
+
+    rebar::object make_array(std::initializer_list<rebar::object> const a_elements) {
+        auto array = env.array(a_elements.size());
+
+        for (auto const & element : a_elements) {
+            array.array_push(element);
+        }
+
+        return array;
+    }
+};
+
+TEST_F(table_test, entries) {
+    auto table = env.table();
+
+    table.table_set(rebar::object(env.str("name")), rebar::object(env.str("rebar")));
+    table.table_set(rebar::object(rebar::integer(2)), rebar::object(rebar::integer(20)));
+
+    EXPECT_EQ(table.table_size(), 2);
+    EXPECT_EQ(table.table_get(rebar::object(env.str("name"))).string_view(), "rebar");
+
+    // Integral numbers and integers address the same entry.
+    EXPECT_EQ(table.table_get(rebar::object(2.0)).get_integer(), 20);
+
+    table.table_set(rebar::object(2.0), rebar::object(rebar::integer(21)));
+    EXPECT_EQ(table.table_size(), 2);
+    EXPECT_EQ(table.table_get(rebar::object(rebar::integer(2))).get_integer(), 21);
+
+    // Assigning null removes the entry.
+    table.table_set(rebar::object(rebar::integer(2)), rebar::object());
+    EXPECT_EQ(table.table_size(), 1);
+    EXPECT_TRUE(table.table_get(rebar::object(rebar::integer(2))).is_null());
+
+    EXPECT_THROW(table.table_set(rebar::object(), rebar::object(rebar::integer(1))), std::invalid_argument);
+    EXPECT_THROW(table.table_set(rebar::object(std::numeric_limits<double>::quiet_NaN()), rebar::object(rebar::integer(1))), std::invalid_argument);
+}
+
+TEST_F(table_test, structural_equality) {
+    auto const lhs = make_array({ rebar::object(rebar::integer(1)), rebar::object(env.str("two")), rebar::object(3.5) });
+    auto const rhs = make_array({ rebar::object(1.0), rebar::object(env.str("two")), rebar::object(3.5) });
+
+    EXPECT_TRUE(lhs.equals(rhs));
+    EXPECT_EQ(lhs.hash(), rhs.hash());
+    EXPECT_FALSE(lhs.equals(make_array({ rebar::object(rebar::integer(1)) })));
+
+    // Tables are equal regardless of insertion order.
+    auto first = env.table();
+    auto second = env.table();
+
+    first.table_set(rebar::object(env.str("a")), rebar::object(rebar::integer(1)));
+    first.table_set(rebar::object(env.str("b")), lhs);
+    second.table_set(rebar::object(env.str("b")), rhs);
+    second.table_set(rebar::object(env.str("a")), rebar::object(rebar::integer(1)));
+
+    EXPECT_TRUE(first.equals(second));
+    EXPECT_EQ(first.hash(), second.hash());
+
+    second.table_set(rebar::object(env.str("a")), rebar::object(rebar::integer(2)));
+    EXPECT_FALSE(first.equals(second));
+}
+
+TEST_F(table_test, numeric_equality) {
+    constexpr rebar::integer limit = rebar::integer(1) << 53;
+
+    rebar::object const exact(static_cast<rebar::number>(limit));
+    rebar::object const above(limit + 1);
+
+    // 2^53 + 1 rounds to 2^53 as a number, but is not equal to it.
+    EXPECT_TRUE(exact.equals(rebar::object(limit)));
+    EXPECT_EQ(exact.hash(), rebar::object(limit).hash());
+    EXPECT_FALSE(above.equals(exact));
+    EXPECT_FALSE(exact.equals(above));
+
+    EXPECT_FALSE(rebar::object(rebar::integer(1)).equals(rebar::object(1.5)));
+    EXPECT_FALSE(rebar::object(std::numeric_limits<rebar::integer>::max()).equals(rebar::object(9223372036854775808.0)));
+
+    auto table = env.table();
+
+    table.table_set(above, rebar::object(env.str("above")));
+    table.table_set(exact, rebar::object(env.str("exact")));
+
+    EXPECT_EQ(table.table_size(), 2);
+    EXPECT_EQ(table.table_get(above).string_view(), "above");
+    EXPECT_EQ(table.table_get(rebar::object(limit)).string_view(), "exact");
+}
+
+TEST_F(table_test, composite_keys) {
+    auto table = env.table();
+
+    table.table_set(make_array({ rebar::object(rebar::integer(4)), rebar::object(rebar::integer(2)) }), rebar::object(env.str("cell")));
+
+    auto const key = make_array({ rebar::object(rebar::integer(4)), rebar::object(rebar::integer(2)) });
+
+    // Repeated lookups reuse the memoized hash of the key.
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(table.table_get(key).string_view(), "cell");
+    }
+
+    EXPECT_TRUE(table.table_get(make_array({ rebar::object(rebar::integer(2)), rebar::object(rebar::integer(4)) })).is_null());
+
+    // Nested tables as keys.
+    auto outer = env.table();
+    auto inner = env.table();
+    inner.table_set(rebar::object(env.str("x")), rebar::object(rebar::integer(1)));
+    outer.table_set(inner, rebar::object(rebar::_true));
+
+    auto lookup = env.table();
+    lookup.table_set(rebar::object(env.str("x")), rebar::object(rebar::integer(1)));
+    EXPECT_EQ(outer.table_get(lookup).get_boolean(), rebar::_true);
+}
+
+TEST_F(table_test, hash_invalidation) {
+    auto array = make_array({ rebar::object(rebar::integer(1)) });
+    auto const before = array.hash();
+
+    array.array_push(rebar::object(rebar::integer(2)));
+    EXPECT_NE(array.hash(), before);
+    EXPECT_EQ(array.hash(), make_array({ rebar::object(rebar::integer(1)), rebar::object(rebar::integer(2)) }).hash());
+
+    array.array_set(1, rebar::object(rebar::integer(3)));
+    EXPECT_EQ(array.hash(), make_array({ rebar::object(rebar::integer(1)), rebar::object(rebar::integer(3)) }).hash());
+
+    // Nested containers are copied on write, so the hashes of whole
+    // structures stay memoized.
+    auto child = make_array({ rebar::object(rebar::integer(1)) });
+    auto const parent = make_array({ child });
+    auto const parent_before = parent.hash();
+
+    EXPECT_TRUE(parent.hash_memoized());
+
+    child.array_push(rebar::object(rebar::integer(5)));
+    EXPECT_TRUE(parent.hash_memoized());
+    EXPECT_EQ(parent.hash(), parent_before);
+
+    // Containers holding natives, which can be mutated in place, are not
+    // memoized.
+    auto const holder = make_array({ make_array({ env.native(handle{ 1 }) }) });
+    static_cast<void>(holder.hash());
+    EXPECT_FALSE(holder.hash_memoized());
+}
+
+TEST_F(table_test, native_equality) {
+    auto const lhs = env.native(point{ 1, 2 });
+    auto const rhs = env.native(point{ 1, 2 });
+
+    EXPECT_TRUE(lhs.equals(rhs));
+    EXPECT_EQ(lhs.hash(), rhs.hash());
+    EXPECT_FALSE(lhs.equals(env.native(point{ 2, 1 })));
+
+    // Natives without an equality operator compare by identity.
+    auto const first = env.native(handle{ 1 });
+    auto const second = env.native(handle{ 1 });
+
+    EXPECT_TRUE(first.equals(first));
+    EXPECT_FALSE(first.equals(second));
+}
+
+TEST_F(table_test, insertion_order) {
+    auto table = env.table();
+
+    for (rebar::integer i = 0; i < 10; ++i) {
+        table.table_set(rebar::object(10 - i), rebar::object(i));
+    }
+
+    // Removed entries leave no gap, and reinserted keys move to the end.
+    table.table_set(rebar::object(rebar::integer(7)), rebar::object());
+    table.table_set(rebar::object(rebar::integer(10)), rebar::object());
+    table.table_set(rebar::object(rebar::integer(10)), rebar::object(rebar::integer(-1)));
+    table.table_set(rebar::object(rebar::integer(5)), rebar::object(rebar::integer(50)));
+
+    std::vector<rebar::integer> keys;
+
+    for (auto const & entry : table.table_entries()) {
+        keys.push_back(entry.key.get_integer());
+    }
+
+    EXPECT_EQ(keys, (std::vector<rebar::integer>{ 9, 8, 6, 5, 4, 3, 2, 1, 10 }));
+    EXPECT_EQ(table.table_get(rebar::object(rebar::integer(5))).get_integer(), 50);
+}
+
+TEST_F(table_test, compact_index) {
+    auto table = env.table();
+
+    // Negative keys are stored in the hash part.
+    auto const key = [](rebar::integer const a_index) {
+        return rebar::object(-1 - a_index);
+    };
+
+    // Small tables use single-byte index slots.
+    for (rebar::integer i = 0; i < 100; ++i) {
+        table.table_set(key(i), rebar::object(i * 2));
+    }
+
+    EXPECT_EQ(table.table_entries().index_width(), 1);
+
+    for (rebar::integer i = 100; i < 1000; ++i) {
+        table.table_set(key(i), rebar::object(i * 2));
+    }
+
+    EXPECT_EQ(table.table_entries().index_width(), 2);
+
+    // Churn leaves tombstones, which are compacted as the table grows.
+    for (rebar::integer i = 0; i < 1000; i += 2) {
+        table.table_set(key(i), rebar::object());
+    }
+
+    for (rebar::integer i = 1000; i < 1500; ++i) {
+        table.table_set(key(i), rebar::object(i * 2));
+    }
+
+    EXPECT_EQ(table.table_size(), 1000);
+
+    for (rebar::integer i = 0; i < 1500; ++i) {
+        auto const value = table.table_get(key(i));
+
+        if (i < 1000 && i % 2 == 0) {
+            EXPECT_TRUE(value.is_null());
+        } else {
+            EXPECT_EQ(value.get_integer(), i * 2);
+        }
+    }
+
+    // Copies are compacted.
+    auto const copy = table;
+    table.table_set(key(1), rebar::object(rebar::integer(0)));
+
+    EXPECT_EQ(copy.table_get(key(1)).get_integer(), 2);
+    EXPECT_EQ(std::distance(copy.table_entries().begin(), copy.table_entries().end()), 1000);
+}
+
+TEST_F(table_test, array_part) {
+    auto table = env.table();
+
+    // Keys inserted ahead of the array part move over once it reaches them.
+    table.table_set(rebar::object(rebar::integer(2)), rebar::object(env.str("c")));
+    table.table_set(rebar::object(rebar::integer(1)), rebar::object(env.str("b")));
+    table.table_set(rebar::object(env.str("name")), rebar::object(env.str("rebar")));
+
+    EXPECT_EQ(table.table_entries().array_part_length(), 0);
+
+    table.table_set(rebar::object(0.0), rebar::object(env.str("a")));
+
+    EXPECT_EQ(table.table_entries().array_part_length(), 3);
+    EXPECT_EQ(table.table_size(), 4);
+    EXPECT_EQ(table.table_get(rebar::object(1.0)).string_view(), "b");
+
+    for (rebar::integer i = 3; i < 100; ++i) {
+        table.table_set(rebar::object(i), rebar::object(i));
+    }
+
+    EXPECT_EQ(table.table_entries().array_part_length(), 100);
+
+    // Removing a key leaves a hole; removing the last keys shrinks the part.
+    table.table_set(rebar::object(rebar::integer(50)), rebar::object());
+    EXPECT_TRUE(table.table_get(rebar::object(rebar::integer(50))).is_null());
+    EXPECT_EQ(table.table_entries().array_part_length(), 100);
+
+    table.table_set(rebar::object(rebar::integer(99)), rebar::object());
+    EXPECT_EQ(table.table_entries().array_part_length(), 99);
+    EXPECT_EQ(table.table_size(), 99);
+
+    // Iteration visits the array part in key order, then the hash part.
+    std::vector<rebar::object> keys;
+
+    for (auto const & entry : table.table_entries()) {
+        keys.push_back(entry.key);
+    }
+
+    ASSERT_EQ(keys.size(), 99);
+    EXPECT_EQ(keys[0].get_integer(), 0);
+    EXPECT_EQ(keys[50].get_integer(), 51);
+    EXPECT_EQ(keys.back().string_view(), "name");
+
+    // Tables are equal regardless of how their integer keys are stored.
+    auto other = env.table();
+
+    for (rebar::integer i = 98; i >= 0; --i) {
+        if (i != 50) {
+            other.table_set(rebar::object(i), table.table_get(rebar::object(i)));
+        }
+    }
+
+    other.table_set(rebar::object(env.str("name")), rebar::object(env.str("rebar")));
+
+    EXPECT_TRUE(table.equals(other));
+    EXPECT_EQ(table.hash(), other.hash());
+}
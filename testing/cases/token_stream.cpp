@@ -0,0 +1,95 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <rebar/lexical_analysis/token_stream.hpp>
+#include <rebar/string/string_engine.hpp>
+
+class token_stream_test : public testing::Test {
+protected:
+    rebar::string_engine m_string_engine;
+    rebar::lexical_analyzer m_lexical_analyzer;
+
+    token_stream_test() :
+        m_lexical_analyzer(m_string_engine)
+    {}
+
+    static std::string plaintext() {
+        return
+            "local_value = first_value + second_value * 42;\n"
+            "if (counter >= 1'000'000 && flag != false) { counter += 1; }\n"
+            "escaped = \"Line one\\nLine two\\t\\\"quoted\\\"\";\n"
+            "ratio = -.125 * (width - 3.75) / height_in_pixels;\n"
+            "functional = function; return_value = true\n"
+            "trailing = -";
+    }
+
+    std::vector<rebar::positioned_token> stream_tokens(std::string const & a_plaintext, std::size_t const a_chunk_size, std::size_t const a_token_capacity) const {
+        std::istringstream input(a_plaintext);
+        rebar::token_stream stream(m_lexical_analyzer, rebar::make_stream_reader(input), a_chunk_size, a_token_capacity);
+
+        std::vector<rebar::positioned_token> tokens;
+
+        while (auto token = stream.next()) {
+            tokens.push_back(std::move(*token));
+        }
+
+        return tokens;
+    }
+};
+
+TEST_F(token_stream_test, matches_sequential_analysis) {
+    auto const text = plaintext();
+
+    rebar::lexical_unit lu(text);
+    m_lexical_analyzer.perform_analysis(lu);
+
+    auto const expected = lu.tokens();
+
+    // Chunks small enough that every kind of token straddles a boundary.
+    for (std::size_t const chunk_size : { 1, 2, 3, 7, 16, 4096 }) {
+        for (std::size_t const token_capacity : { 1, 5, 4096 }) {
+            auto const tokens = stream_tokens(text, chunk_size, token_capacity);
+
+            ASSERT_EQ(tokens.size(), expected.size()) << "Chunk size " << chunk_size << ", capacity " << token_capacity << '.';
+
+            for (std::size_t i = 0; i < tokens.size(); ++i) {
+                EXPECT_EQ(tokens[i].value, expected[i]) << "Token " << i << ", chunk size " << chunk_size << '.';
+                EXPECT_EQ(tokens[i].position, lu.token_positions()[i]) << "Token " << i << ", chunk size " << chunk_size << '.';
+            }
+        }
+    }
+}
+
+TEST_F(token_stream_test, empty_input) {
+    EXPECT_TRUE(stream_tokens("", 16, 16).empty());
+    EXPECT_TRUE(stream_tokens(" \n\t ", 1, 1).empty());
+}
+
+TEST_F(token_stream_test, bounded_ring) {
+    rebar::token_ring ring(2);
+
+    auto const consumed = m_lexical_analyzer.perform_partial_analysis("a + b + c;", 100, true, ring);
+
+    // Analysis stops once the ring is full, and resumes after the last
+    // token.
+    EXPECT_TRUE(ring.full());
+    EXPECT_EQ(consumed, 3);
+    EXPECT_EQ(ring.pop().position, 100);
+    EXPECT_TRUE(ring.pop().value == rebar::symbol::plus);
+    EXPECT_TRUE(ring.empty());
+
+    // Tokens that may continue past a non-final part are left unconsumed.
+    rebar::token_ring partial_ring(4);
+
+    EXPECT_EQ(m_lexical_analyzer.perform_partial_analysis("alpha + beta_value", 0, false, partial_ring), 8);
+    EXPECT_EQ(partial_ring.size(), 2);
+
+    EXPECT_THROW(rebar::token_ring(0), std::invalid_argument);
+}
@@ -0,0 +1,192 @@
+//
+// Created by maxng on 18/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include <rebar/environment/environment.hpp>
+#include <rebar/environment/frozen.hpp>
+#include <rebar/environment/table.hpp>
+
+namespace {
+
+    struct handle {
+        int id;
+    };
+
+}
+
+class weak_table_test : public testing::Test {
+protected:
+    rebar::environment env;
+
+    rebar::object make_array(rebar::integer const a_value) {
+        auto array = env.array(1);
+        array.array_push(rebar::object(a_value));
+
+        return array;
+    }
+};
+
+TEST_F(weak_table_test, weak_keys) {
+    auto cache = env.table(rebar::table_mode::weak_keys);
+
+    auto first = make_array(1);
+    auto second = make_array(2);
+
+    cache.table_set(first, rebar::object(env.str("one")));
+    cache.table_set(second, rebar::object(env.str("two")));
+    cache.table_set(rebar::object(env.str("name")), rebar::object(env.str("cache")));
+
+    EXPECT_EQ(cache.table_size(), 3);
+    EXPECT_EQ(cache.table_get(first).string_view(), "one");
+
+    // Weakly held keys are compared by identity.
+    EXPECT_TRUE(cache.table_get(make_array(1)).is_null());
+
+    // Destroying a key removes its entry; strings are held strongly.
+    first = rebar::object();
+
+    EXPECT_EQ(cache.table_size(), 2);
+    EXPECT_TRUE(cache.table_get(make_array(1)).is_null());
+    EXPECT_EQ(cache.table_get(second).string_view(), "two");
+    EXPECT_EQ(cache.table_get(rebar::object(env.str("name"))).string_view(), "cache");
+
+    // Keys referenced nowhere else are never stored.
+    cache.table_set(make_array(3), rebar::object(rebar::integer(3)));
+    EXPECT_EQ(cache.table_size(), 2);
+
+    // Removing an entry releases the key normally.
+    cache.table_set(second, rebar::object());
+    EXPECT_EQ(cache.table_size(), 1);
+    EXPECT_EQ(second.array_at(0).get_integer(), 2);
+}
+
+TEST_F(weak_table_test, mutated_keys) {
+    auto cache = env.table(rebar::table_mode::weak_keys);
+
+    auto key = make_array(1);
+    cache.table_set(key, rebar::object(rebar::integer(10)));
+
+    // The table gives up its reference, so the key is modified in place,
+    // but its entry remains reachable.
+    key.array_push(rebar::object(rebar::integer(2)));
+
+    EXPECT_EQ(cache.table_get(key).get_integer(), 10);
+
+    cache.table_set(key, rebar::object(rebar::integer(20)));
+
+    EXPECT_EQ(cache.table_size(), 1);
+    EXPECT_EQ(cache.table_get(key).get_integer(), 20);
+
+    key = rebar::object();
+
+    EXPECT_EQ(cache.table_size(), 0);
+}
+
+TEST_F(weak_table_test, weak_values) {
+    auto registry = env.table(rebar::table_mode::weak_values);
+
+    auto value = env.native(handle{ 7 });
+
+    for (rebar::integer i = 0; i < 4; ++i) {
+        registry.table_set(rebar::object(i), value);
+    }
+
+    registry.table_set(rebar::object(env.str("pinned")), rebar::object(rebar::integer(1)));
+
+    EXPECT_EQ(registry.table_size(), 5);
+    EXPECT_EQ(registry.table_entries().array_part_length(), 0);
+
+    // Replacing a weakly held value releases the previous one.
+    auto replacement = env.native(handle{ 8 });
+    registry.table_set(rebar::object(rebar::integer(0)), replacement);
+
+    value = rebar::object();
+
+    EXPECT_EQ(registry.table_size(), 2);
+    EXPECT_EQ(rebar::native_cast<handle>(registry.table_get(rebar::object(rebar::integer(0))))->id, 8);
+    EXPECT_EQ(registry.table_get(rebar::object(env.str("pinned"))).get_integer(), 1);
+
+    replacement = rebar::object();
+
+    EXPECT_EQ(registry.table_size(), 1);
+}
+
+TEST_F(weak_table_test, lifetimes) {
+    auto key = make_array(1);
+
+    {
+        // Destroying a weak table leaves its weakly held objects alive.
+        auto cache = env.table(rebar::table_mode::weak_keys);
+        cache.table_set(key, rebar::object(rebar::integer(1)));
+    }
+
+    EXPECT_EQ(key.array_at(0).get_integer(), 1);
+
+    // Copies of weak tables hold their entries weakly too.
+    auto cache = env.table(rebar::table_mode::weak_keys);
+    cache.table_set(key, rebar::object(rebar::integer(1)));
+
+    auto copy = cache;
+    copy.table_set(rebar::object(env.str("extra")), rebar::object(rebar::integer(2)));
+
+    EXPECT_EQ(copy.table_size(), 2);
+
+    key = rebar::object();
+
+    EXPECT_EQ(cache.table_size(), 0);
+    EXPECT_EQ(copy.table_size(), 1);
+
+    // Weak tables nested in the entries of weak tables are released as
+    // their keys die.
+    auto outer_key = make_array(2);
+    auto inner_key = make_array(3);
+
+    auto outer = env.table(rebar::table_mode::weak_keys);
+    auto inner = env.table(rebar::table_mode::weak_keys);
+
+    inner.table_set(inner_key, rebar::object(rebar::integer(3)));
+    outer.table_set(outer_key, inner);
+    inner = rebar::object();
+
+    // The inner table is destroyed along with the entry, unregistering its
+    // own weakly held key.
+    outer_key = rebar::object();
+    EXPECT_EQ(outer.table_size(), 0);
+
+    inner_key = rebar::object();
+}
+
+TEST_F(weak_table_test, allocations) {
+    auto const baseline = env.allocator_statistics().used_bytes();
+
+    {
+        auto cache = env.table(rebar::table_mode::weak_keys);
+
+        for (rebar::integer i = 0; i < 100; ++i) {
+            auto key = make_array(i);
+            cache.table_set(key, rebar::object(i));
+        }
+
+        EXPECT_EQ(cache.table_size(), 0);
+    }
+
+    EXPECT_EQ(env.allocator_statistics().used_bytes(), baseline);
+}
+
+TEST_F(weak_table_test, frozen) {
+    auto key = make_array(1);
+
+    auto cache = env.table(rebar::table_mode::weak_keys);
+    cache.table_set(key, rebar::object(rebar::integer(1)));
+
+    // Frozen objects are never destroyed, so frozen copies hold their
+    // entries strongly.
+    auto const graph = rebar::frozen_graph::freeze(cache);
+
+    key = rebar::object();
+
+    EXPECT_EQ(cache.table_size(), 0);
+    EXPECT_EQ(graph.root().table_size(), 1);
+}